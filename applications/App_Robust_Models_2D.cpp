@@ -61,9 +61,6 @@ int CreateGraphAndSolve(std::vector<std::string> &Arguments,
   /** estimate DCS parameter */
   const double ScalingDCS = std::pow(10, Mean2(0));
 
-  /** create our own graph object */
-  libRSF::FactorGraph SimpleGraph;
-
   /** set the solver options for ceres */
   ceres::Solver::Options SolverOptions;
   SolverOptions.linear_solver_type = ceres::LinearSolverType::DENSE_QR;
@@ -99,45 +96,58 @@ int CreateGraphAndSolve(std::vector<std::string> &Arguments,
   /** create initial values */
   libRSF::Vector InitialValues = libRSF::Vector::LinSpaced(NumberPoints, -Range / 2, Range / 2);
 
-  /** add state to graph */
-  SimpleGraph.addState(POSITION_STATE, libRSF::DataType::Point2, 0.0);
-
-  /** add factor to graph */
-  if (ErrorModel.compare("Gaussian") == 0)
-  {
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, Noise);
-  }
-  else if (ErrorModel.compare("MaxMix") == 0)
-  {
-    libRSF::MaxMix2 MixtureNoiseMM(GMM);
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseMM);
-  }
-  else if (ErrorModel.compare("SumMix") == 0)
-  {
-    libRSF::SumMix2 MixtureNoiseSM(GMM);
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseSM);
-  }
-  else if (ErrorModel.compare("SumMixSpecial") == 0)
-  {
-    libRSF::SumMix2Special MixtureNoiseSMSpecial(GMM);
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseSMSpecial);
-  }
-  else if (ErrorModel.compare("MaxSumMix") == 0)
+  /** the problem is created once per worker thread */
+  auto BuildGraph = [&](libRSF::FactorGraph &SimpleGraph)
   {
-    libRSF::MaxSumMix2 MixtureNoiseMSM(GMM);
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseMSM);
-  }
-  else if (ErrorModel.compare("DCS") == 0)
-  {
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, Noise, new libRSF::DCSLoss(ScalingDCS));
-  }
-  else if (ErrorModel.compare("cDCE") == 0)
-  {
-    SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, NoiseIdentity, new libRSF::cDCELoss(StdDev1(0)));
-  }
-  else
+    /** add state to graph */
+    SimpleGraph.addState(POSITION_STATE, libRSF::DataType::Point2, 0.0);
+
+    /** add factor to graph */
+    if (ErrorModel.compare("Gaussian") == 0)
+    {
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, Noise);
+    }
+    else if (ErrorModel.compare("MaxMix") == 0)
+    {
+      libRSF::MaxMix2 MixtureNoiseMM(GMM);
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseMM);
+    }
+    else if (ErrorModel.compare("SumMix") == 0)
+    {
+      libRSF::SumMix2 MixtureNoiseSM(GMM);
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseSM);
+    }
+    else if (ErrorModel.compare("SumMixSpecial") == 0)
+    {
+      libRSF::SumMix2Special MixtureNoiseSMSpecial(GMM);
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseSMSpecial);
+    }
+    else if (ErrorModel.compare("MaxSumMix") == 0)
+    {
+      libRSF::MaxSumMix2 MixtureNoiseMSM(GMM);
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, MixtureNoiseMSM);
+    }
+    else if (ErrorModel.compare("DCS") == 0)
+    {
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, Noise, new libRSF::DCSLoss(ScalingDCS));
+    }
+    else if (ErrorModel.compare("cDCE") == 0)
+    {
+      SimpleGraph.addFactor<libRSF::FactorType::Prior2>(libRSF::StateID(POSITION_STATE, 0.0, 0), AbsoluteMeasurement, NoiseIdentity, new libRSF::cDCELoss(StdDev1(0)));
+    }
+    else
+    {
+      PRINT_ERROR("Wrong error model: ", ErrorModel);
+      return false;
+    }
+
+    return true;
+  };
+
+  /** create our own graph object */
+  libRSF::FactorGraph SimpleGraph;
+  if (BuildGraph(SimpleGraph) == false)
   {
-    PRINT_ERROR("Wrong error model: ", ErrorModel);
     return 1;
   }
 
@@ -145,37 +155,26 @@ int CreateGraphAndSolve(std::vector<std::string> &Arguments,
   SimpleGraph.getStateData().getElement(POSITION_STATE, 0.0).setMean(libRSF::Vector2::Zero());
   SimpleGraph.sampleCost2D(POSITION_STATE, 0.0, 0, NumberPoints, Range, CostSurfaceData);
 
-  /** nested loop over points */
+  /** collect initial points in the order of the nested loop */
+  libRSF::VectorVectorSTL<libRSF::Dynamic> InitialPoints;
   for (int nPointX = 0; nPointX < NumberPoints; nPointX++)
   {
     for (int nPointY = 0; nPointY < NumberPoints; nPointY++)
     {
-      /** construct initial value */
       libRSF::Vector2 Init;
       Init(0) = InitialValues(nPointX);
       Init(1) = InitialValues(nPointY);
-
-      /** init state with value */
-      SimpleGraph.getStateData().getElement(POSITION_STATE, 0.0).setMean(Init);
-
-      /** save initial point */
-      PreOptimizationData.addElement(POSITION_STATE, 0.0, SimpleGraph.getStateData().getElement(POSITION_STATE, 0.0));
-
-      /** optimize */
-      SimpleGraph.solve(SolverOptions);
-
-      /** save result */
-      PostOptimizationData.addElement(POSITION_STATE, 0.0, SimpleGraph.getStateData().getElement(POSITION_STATE, 0.0));
-
-      /** save solution information */
-      SolverData.addElement(SOLVE_TIME_STATE, libRSF::DataType::IterationSummary, 0.0);
-      SolverData.getElement(SOLVE_TIME_STATE, 0.0, nPointX*NumberPoints+nPointY).setValueScalar(libRSF::DataElement::DurationSolver, SimpleGraph.getSolverDurationAndReset());
-      SolverData.getElement(SOLVE_TIME_STATE, 0.0, nPointX*NumberPoints+nPointY).setValueScalar(libRSF::DataElement::IterationSolver, SimpleGraph.getSolverIterationsAndReset());
-
-      libRSF::PrintProgress((100.0*nPointX)/NumberPoints);
+      InitialPoints.emplace_back(Init);
     }
   }
 
+  /** optimize from all initial points in parallel */
+  if (libRSF::SolveMultiStart(BuildGraph, SolverOptions, libRSF::StateID(POSITION_STATE, 0.0, 0), InitialPoints,
+                              PreOptimizationData, PostOptimizationData, SolverData, SOLVE_TIME_STATE) == false)
+  {
+    return 1;
+  }
+
   /** modify timestamps for identification */
   for (int nPoint = PostOptimizationData.countElement(POSITION_STATE, 0.0) - 1; nPoint >= 0; nPoint--)
   {
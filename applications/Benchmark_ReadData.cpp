@@ -0,0 +1,102 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+/**
+ * @file Benchmark_ReadData.cpp
+ * @author libRSF contributors
+ * @date 15 Oct 2026
+ * @brief Compares the runtime of the different dataset readers.
+ *
+ * The former reader is not part of the comparison, because it depends on the former layout of the data objects.
+ * To compare against it, time ReadDataFromFile() of an older release on the same files.
+ * @copyright GNU Public License.
+ *
+ */
+
+#include "libRSF.h"
+
+int CountMeasurements(libRSF::SensorDataSet &SensorData)
+{
+  int Count = 0;
+  for (const libRSF::DataType Type : SensorData.getKeysAll())
+  {
+    Count += SensorData.countElements(Type);
+  }
+  return Count;
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> Files;
+  if (argc > 1)
+  {
+    Files.assign(argv + 1, argv + argc);
+  }
+  else
+  {
+    Files = {"datasets/smartLoc/Berlin_Gendarmenmarkt_Input.txt",
+             "datasets/smartLoc/Berlin_Potsdamer_Platz_Input.txt",
+             "datasets/smartLoc/Frankfurt_Main_Tower_Input.txt",
+             "datasets/smartLoc/Frankfurt_Westend_Tower_Input.txt"};
+  }
+
+  const int Runs = 5;
+  const std::string BinaryFile = "Benchmark_ReadData.rsfb";
+
+  for (const std::string &File : Files)
+  {
+    libRSF::ConvertDataFileToBinary(File, BinaryFile);
+
+    double DurationText = 0, DurationParallel = 0, DurationBinary = 0;
+    int CountText = 0, CountParallel = 0, CountBinary = 0;
+
+    for (int n = 0; n < Runs; n++)
+    {
+      libRSF::SensorDataSet DataText, DataParallel, DataBinary;
+      libRSF::Timer Timer;
+
+      libRSF::ReadDataFromFile(File, DataText);
+      DurationText += Timer.getMilliseconds();
+
+      Timer.reset();
+      libRSF::ReadDataFromFileParallel(File, DataParallel);
+      DurationParallel += Timer.getMilliseconds();
+
+      Timer.reset();
+      libRSF::ReadDataFromBinaryFile(BinaryFile, DataBinary);
+      DurationBinary += Timer.getMilliseconds();
+
+      CountText = CountMeasurements(DataText);
+      CountParallel = CountMeasurements(DataParallel);
+      CountBinary = CountMeasurements(DataBinary);
+    }
+
+    std::cout << File << std::endl;
+    std::cout << "  text:        " << DurationText / Runs << " ms (" << CountText << " measurements)" << std::endl;
+    std::cout << "  parallel:    " << DurationParallel / Runs << " ms (" << CountParallel << " measurements)" << std::endl;
+    std::cout << "  binary:      " << DurationBinary / Runs << " ms (" << CountBinary << " measurements)" << std::endl;
+  }
+
+  std::remove(BinaryFile.c_str());
+
+  return 0;
+}
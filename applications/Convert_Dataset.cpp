@@ -0,0 +1,48 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+/**
+ * @file Convert_Dataset.cpp
+ * @author libRSF contributors
+ * @date 15 Oct 2026
+ * @brief Converts an ASCII dataset into the binary format of libRSF.
+ * @copyright GNU Public License.
+ *
+ */
+
+#include "libRSF.h"
+
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+  {
+    PRINT_ERROR("Wrong number of arguments! Usage: Convert_Dataset <input.txt> <output.rsfb>");
+    return 1;
+  }
+
+  if (!libRSF::ConvertDataFileToBinary(argv[1], argv[2]))
+  {
+    return 1;
+  }
+
+  return 0;
+}
@@ -31,6 +31,15 @@
 
 #include "ICRA19_GNSS.h"
 
+/** default error model */
+static const libRSF::GaussianMixture<1> GMMDefault((libRSF::Vector2() << 0, 0).finished(),
+                                                   (libRSF::Vector2() << 10, 100).finished(),
+                                                   (libRSF::Vector2() << 0.5, 0.5).finished());
+
+/** all pseudorange factors share one mixture, so tuning replaces it only once */
+static libRSF::SharedMaxMix1 NoisePseudorangeMaxMix((libRSF::MaxMix1(GMMDefault)));
+static libRSF::SharedSumMix1 NoisePseudorangeSumMix((libRSF::SumMix1(GMMDefault)));
+
 /** @brief Build the factor Graph with initial values and a first set of measurements
  *
  * @param Graph reference to the factor graph object
@@ -70,6 +79,10 @@ void InitGraph(libRSF::FactorGraph &Graph,
   Graph.getStateData().getElement(CLOCK_ERROR_STATE, TimestampFirst).setMean(SimpleGraph.getStateData().getElement(CLOCK_ERROR_STATE, TimestampFirst).getMean());
 
 
+  /** start with the default error model */
+  NoisePseudorangeMaxMix.setModel(libRSF::MaxMix1(GMMDefault));
+  NoisePseudorangeSumMix.setModel(libRSF::SumMix1(GMMDefault));
+
   /** add first set of measurements */
   AddPseudorangeMeasurements(Graph, Measurements, Config, TimestampFirst);
 }
@@ -96,6 +109,26 @@ void AddPseudorangeMeasurements(libRSF::FactorGraph &Graph,
   ListPseudorange.add(POSITION_STATE, Timestamp);
   ListPseudorange.add(CLOCK_ERROR_STATE, Timestamp);
 
+  /** the mixture is shared by all satellites, so the whole epoch is added at once */
+  if (Config.GNSS.ErrorModel.Type == libRSF::ErrorModelType::GMM)
+  {
+    const std::vector<libRSF::Data> Pseudoranges = Measurements.getElements(libRSF::DataType::Pseudorange3, Timestamp);
+
+    if (Config.GNSS.ErrorModel.MixtureType == libRSF::ErrorModelMixtureType::MaxMix)
+    {
+      Graph.addFactors<libRSF::FactorType::Pseudorange3_ECEF>(ListPseudorange, Pseudoranges, NoisePseudorangeMaxMix);
+    }
+    else if (Config.GNSS.ErrorModel.MixtureType == libRSF::ErrorModelMixtureType::SumMix)
+    {
+      Graph.addFactors<libRSF::FactorType::Pseudorange3_ECEF>(ListPseudorange, Pseudoranges, NoisePseudorangeSumMix);
+    }
+    else
+    {
+      PRINT_ERROR("Wrong error model mixture type!");
+    }
+    return;
+  }
+
   int SatNumber = Measurements.countElement(libRSF::DataType::Pseudorange3, Timestamp);
 
   for(int SatCounter = 0; SatCounter < SatNumber; ++SatCounter)
@@ -103,11 +136,6 @@ void AddPseudorangeMeasurements(libRSF::FactorGraph &Graph,
     /** get measurement */
     Pseudorange = Measurements.getElement(libRSF::DataType::Pseudorange3, Timestamp, SatCounter);
 
-    /** default error model */
-    static libRSF::GaussianMixture<1> GMM((libRSF::Vector2() << 0, 0).finished(),
-                                           (libRSF::Vector2() << 10, 100).finished(),
-                                           (libRSF::Vector2() << 0.5, 0.5).finished());
-
     /** add factor */
     switch(Config.GNSS.ErrorModel.Type)
     {
@@ -126,24 +154,6 @@ void AddPseudorangeMeasurements(libRSF::FactorGraph &Graph,
         Graph.addFactor<libRSF::FactorType::Pseudorange3_ECEF>(ListPseudorange, Pseudorange, NoisePseudorange, new libRSF::cDCELoss(Pseudorange.getStdDevDiagonal()[0]));
         break;
 
-      case libRSF::ErrorModelType::GMM:
-        if (Config.GNSS.ErrorModel.MixtureType == libRSF::ErrorModelMixtureType::MaxMix)
-        {
-          static libRSF::MaxMix1 NoisePseudorangeMaxMix(GMM);
-          Graph.addFactor<libRSF::FactorType::Pseudorange3_ECEF>(ListPseudorange, Pseudorange, NoisePseudorangeMaxMix);
-        }
-        else if (Config.GNSS.ErrorModel.MixtureType == libRSF::ErrorModelMixtureType::SumMix)
-        {
-          static libRSF::SumMix1 NoisePseudorangeSumMix(GMM);
-          Graph.addFactor<libRSF::FactorType::Pseudorange3_ECEF>(ListPseudorange, Pseudorange, NoisePseudorangeSumMix);
-        }
-        else
-        {
-          PRINT_ERROR("Wrong error model mixture type!");
-        }
-
-        break;
-
       default:
         PRINT_ERROR("Wrong error model type: ", Config.GNSS.ErrorModel.Type);
         break;
@@ -196,16 +206,14 @@ void TuneErrorModel(libRSF::FactorGraph &Graph,
     /** remove offset of the first "LOS" component */
     GMM.removeOffset();
 
-    /** apply error model */
+    /** apply error model to all factors at once */
     if(Config.GNSS.ErrorModel.MixtureType == libRSF::ErrorModelMixtureType::SumMix)
     {
-      libRSF::SumMix1 NewSMModel(GMM);
-      Graph.setNewErrorModel(libRSF::FactorType::Pseudorange3_ECEF, NewSMModel);
+      NoisePseudorangeSumMix.setModel(libRSF::SumMix1(GMM));
     }
     else if(Config.GNSS.ErrorModel.MixtureType == libRSF::ErrorModelMixtureType::MaxMix)
     {
-      libRSF::MaxMix1 NewMMModel(GMM);
-      Graph.setNewErrorModel(libRSF::FactorType::Pseudorange3_ECEF, NewMMModel);
+      NoisePseudorangeMaxMix.setModel(libRSF::MaxMix1(GMM));
     }
   }
 }
@@ -375,8 +383,7 @@ int CreateGraphAndSolve(std::vector<std::string> &Arguments,
     Result.addElement(POSITION_STATE, Graph.getStateData().getElement(POSITION_STATE, Timestamp, 0));
 
     /** apply sliding window */
-    Graph.removeAllFactorsOutsideWindow(60, Timestamp);
-    Graph.removeAllStatesOutsideWindow(60, Timestamp);
+    Graph.slideWindow(Timestamp, 60, libRSF::WindowPolicy::Remove);
 
     /** save time stamp */
     TimestampOld = Timestamp;
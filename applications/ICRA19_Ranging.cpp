@@ -303,12 +303,8 @@ int main(int argc, char** argv)
   libRSF::StateDataSet Result;
   libRSF::Data DeltaTime;
 
-  double Timestamp = 0.0, TimestampFirst = 0.0, TimestampOld = 0.0, TimestampLast = 0.0;
+  double TimestampFirst = 0.0;
   InputData.getTimeFirst(libRSF::DataType::Range2, TimestampFirst);
-  InputData.getTimeLast(libRSF::DataType::Range2, TimestampLast);
-  Timestamp = TimestampFirst;
-  TimestampOld = TimestampFirst;
-  int nTimestamp = 0;
 
   /** add fist variables and factors */
   InitGraph(Graph, InputData, Config, SolverOptions, TimestampFirst);
@@ -317,50 +313,51 @@ int main(int argc, char** argv)
   Graph.solve(SolverOptions);
 
   /** safe result at first timestamp */
-  Result.addElement(POSITION_STATE, Graph.getStateData().getElement(POSITION_STATE, Timestamp, 0));
+  Result.addElement(POSITION_STATE, Graph.getStateData().getElement(POSITION_STATE, TimestampFirst, 0));
 
   /** get odometry noise from first measurement */
-  libRSF::Data Odom = InputData.getElement(libRSF::DataType::Odom2Diff, Timestamp);
+  libRSF::Data Odom = InputData.getElement(libRSF::DataType::Odom2Diff, TimestampFirst);
   libRSF::GaussianDiagonal<3> NoiseOdom2Diff;
   NoiseOdom2Diff.setStdDevDiagonal(Odom.getStdDevDiagonal());
 
-  /** iterate over timestamps */
-  while(InputData.getTimeNext(libRSF::DataType::Range2, Timestamp, Timestamp))
+  /** the loop is a sliding window over all range measurements */
+  Config.Solution.Type = libRSF::SolutionType::Window;
+  Config.Solution.WindowLength = 60;
+  Config.Solution.Marginalize = false;
+  Config.Solution.IsAsync = false;
+  Config.Solution.SyncSensor = libRSF::DataType::Range2;
+  Config.Solution.EstimateCov = false;
+  Config.SolverConfig = SolverOptions;
+
+  libRSF::EstimationPipeline Pipeline(Config,
+                                      [&](libRSF::FactorGraph &Graph, libRSF::SensorDataSet &Measurements, const double TimeOld, const double TimeNow)
   {
-
     /** add required states */
-    Graph.addState(POSITION_STATE, libRSF::DataType::Point2, Timestamp);
-    Graph.addState(ORIENTATION_STATE, libRSF::DataType::Angle, Timestamp);
+    Graph.addState(POSITION_STATE, libRSF::DataType::Point2, TimeNow);
+    Graph.addState(ORIENTATION_STATE, libRSF::DataType::Angle, TimeNow);
 
     /** add motion model or odometry */
     libRSF::StateList MotionList;
-    MotionList.add(POSITION_STATE, TimestampOld);
-    MotionList.add(ORIENTATION_STATE, TimestampOld);
-    MotionList.add(POSITION_STATE, Timestamp);
-    MotionList.add(ORIENTATION_STATE, Timestamp);
-    Graph.addFactor<libRSF::FactorType::Odom2Diff>(MotionList, InputData.getElement(libRSF::DataType::Odom2Diff, Timestamp), NoiseOdom2Diff);
+    MotionList.add(POSITION_STATE, TimeOld);
+    MotionList.add(ORIENTATION_STATE, TimeOld);
+    MotionList.add(POSITION_STATE, TimeNow);
+    MotionList.add(ORIENTATION_STATE, TimeNow);
+    Graph.addFactor<libRSF::FactorType::Odom2Diff>(MotionList, Measurements.getElement(libRSF::DataType::Odom2Diff, TimeNow), NoiseOdom2Diff);
 
     /** add all range measurements of with current timestamp */
-    AddRangeMeasurements2D(Graph, InputData, Config, Timestamp);
+    AddRangeMeasurements2D(Graph, Measurements, Config, TimeNow);
 
     /** tune self-tuning error model */
     TuneErrorModel(Graph, Config, NumberOfComponents);
-
-    /** solve factor graph*/
-    Graph.solve(SolverOptions);
-
+  },
+  [](libRSF::FactorGraph &Graph, const double TimeNow, libRSF::StateDataSet &Result)
+  {
     /** save data after optimization */
-    Result.addElement(POSITION_STATE, Graph.getStateData().getElement(POSITION_STATE, Timestamp, 0));
-
-    /** apply sliding window */
-    Graph.removeAllFactorsOutsideWindow(60, Timestamp);
-    Graph.removeAllStatesOutsideWindow(60, Timestamp);
-
-    /** save time stamp */
-    TimestampOld = Timestamp;
+    Result.addElement(POSITION_STATE, Graph.getStateData().getElement(POSITION_STATE, TimeNow, 0));
+  });
 
-    nTimestamp++;
-  }
+  /** iterate over timestamps */
+  Pipeline.run(Graph, InputData, TimestampFirst, Result);
 
   /** print last report */
   Graph.printReport();
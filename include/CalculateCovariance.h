@@ -33,6 +33,7 @@
 #define CALCULATECOVARIANCE_H
 
 #include "FactorGraphSampling.h"
+#include "LocalCostEvaluator.h"
 #include "VectorTypes.h"
 #include "StateDataSet.h"
 #include "Messages.h"
@@ -42,6 +43,7 @@
 
 #include <vector>
 #include <thread>
+#include <unordered_set>
 
 namespace libRSF
 {
@@ -74,6 +76,21 @@ namespace libRSF
                            const int StateNumber = 0);
 
 
+  /** @brief Calculates the Covariance of multiple states with a single factorization.
+   *
+   * @param ceres::Problem& Graph The graph that contains the factors.
+   * @param libRSF::StateDataSet &States Struct that constains the data of the Graph. The Covariance is saved here!
+   * @param std::vector<StateID> StateIDs All states that are required.
+   * @param Matrix* JointCovariance Optional, the full covariance including cross-covariances in the order of StateIDs, repeated states appear only once.
+   * @return true if everything works fine.
+   *
+   */
+  bool CalculateCovariance(ceres::Problem &Graph,
+                           StateDataSet &States,
+                           const std::vector<StateID> &StateIDs,
+                           Matrix * const JointCovariance = nullptr);
+
+
   /** \brief Compute the covariance based on a numerical estimation of the Hessian
    *
    * \param Grid<Dim, 3> CostGrid A class that holds the evaluated cost surface with multiple (Dim) dimensions.
@@ -162,7 +179,7 @@ namespace libRSF
 
       /** create the required evaluation points */
       VectorVectorSTL<Dim> Indices;
-      VectorVectorSTL<Dynamic> Points;
+      VectorVectorSTL<Dim> Points;
 
       /** add center point */
       Indices.emplace_back(VectorStatic<Dim>::Ones());
@@ -207,8 +224,12 @@ namespace libRSF
       }
 
       /** evaluate sigma points */
-      std::vector<double> Cost;
-      EvaluateCostSurfacePoints(Graph, StatePointer, Dim, Points, Cost);
+      LocalCostEvaluator<Dim> Evaluator(Graph, StatePointer);
+      std::vector<double> Cost(Points.size());
+      for (int nPoint = 0; nPoint < static_cast<int>(Points.size()); nPoint++)
+      {
+        Evaluator.evaluate(Points.at(nPoint), Cost.at(nPoint));
+      }
 
       /** parse them into a tensor */
       Tensor<Dim, 3> CostTensor;
@@ -49,7 +49,7 @@ namespace libRSF
       Data(DataType Type, double Timestamp);
 
       /** string interface for files */
-      explicit Data(std::string Input);
+      explicit Data(std::string_view Input);
 
       /** specific getters */
       double getTimestamp() const;
@@ -35,6 +35,8 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <functional>
 
 namespace libRSF
 {
@@ -53,6 +55,14 @@ namespace libRSF
       } InitType;
       typedef std::vector<InitType> InitVect;
 
+      /** position of each element inside one contiguous buffer */
+      struct LayoutType
+      {
+        int Size = 0;                 /**< length of the whole buffer */
+        std::vector<int> Offset;      /**< indexed by the element enum, -1 if the element does not exist */
+        std::vector<int> Length;
+      };
+
       /** disable the default constructor construction */
       DataConfig() = delete;
 
@@ -64,6 +74,7 @@ namespace libRSF
           _TypeMap.emplace(Init._Type, Init._Elements);
           _NameTypeMap.emplace(Init._Name, Init._Type);
           _TypeNameMap.emplace(Init._Type, Init._Name);
+          _LayoutMap.emplace(Init._Type, CreateLayout(Init._Elements));
         }
       }
 
@@ -71,7 +82,7 @@ namespace libRSF
       virtual ~DataConfig() = default;
 
       /** query string */
-      std::string getName(TypeEnum Type) const
+      const std::string &getName(TypeEnum Type) const
       {
         return _TypeNameMap.at(Type);
       }
@@ -81,6 +92,18 @@ namespace libRSF
         return _NameTypeMap.at(Name);
       }
 
+      /** lookup without creating a temporary string */
+      bool findType(std::string_view Name, TypeEnum &Type) const
+      {
+        const auto It = _NameTypeMap.find(Name);
+        if (It == _NameTypeMap.end())
+        {
+          return false;
+        }
+        Type = It->second;
+        return true;
+      }
+
       /** check type or string */
       bool checkName(std::string Name) const
       {
@@ -103,10 +126,37 @@ namespace libRSF
         return _TypeMap.at(Type);
       }
 
+      /** query precomputed memory layout */
+      const LayoutType &getLayout(TypeEnum Type) const
+      {
+        return _LayoutMap.at(Type);
+      }
+
     private:
-      std::map<std::string, TypeEnum> _NameTypeMap;
+      /** elements are stored in the order of the configuration */
+      static LayoutType CreateLayout(const ConfigType &Config)
+      {
+        LayoutType Layout;
+        for (const auto &Element : Config)
+        {
+          const int ElementIndex = static_cast<int>(Element.first);
+          if (ElementIndex >= static_cast<int>(Layout.Offset.size()))
+          {
+            Layout.Offset.resize(ElementIndex + 1, -1);
+            Layout.Length.resize(ElementIndex + 1, 0);
+          }
+
+          Layout.Offset.at(ElementIndex) = Layout.Size;
+          Layout.Length.at(ElementIndex) = Element.second;
+          Layout.Size += Element.second;
+        }
+        return Layout;
+      }
+
+      std::map<std::string, TypeEnum, std::less<>> _NameTypeMap;
       std::map<TypeEnum, std::string> _TypeNameMap;
       std::map<TypeEnum, ConfigType> _TypeMap;
+      std::map<TypeEnum, LayoutType> _LayoutMap;
   };
 }
 
@@ -38,6 +38,8 @@
 
 #include <cstdio>
 #include <string>
+#include <string_view>
+#include <charconv>
 
 namespace libRSF
 {
@@ -45,6 +47,7 @@ namespace libRSF
   class DataGeneric
   {
     typedef DataConfig<TypeEnum, ElementEnum> ConfigType;
+    typedef typename ConfigType::LayoutType LayoutType;
 
     public:
       DataGeneric() = default;
@@ -58,72 +61,123 @@ namespace libRSF
 
       std::string getName() const
       {
-        return _Name;
+        if (_Layout == nullptr)
+        {
+          return std::string(); /**< not constructed yet */
+        }
+        return _Config->getName(_Type);
       }
 
       /** get elements */
       Vector getValue(const ElementEnum Element) const
       {
-        return _Data.at(Element);
+        if (!this->checkElementSafe(Element))
+        {
+          return Vector();
+        }
+        return _Data.segment(this->getOffset(Element), this->getLength(Element));
       }
 
       /** get pointers */
       double* getDataPointer(const ElementEnum Element)
       {
-        return _Data.at(Element).data();
+        if (!this->checkElementSafe(Element))
+        {
+          return nullptr;
+        }
+        return _Data.data() + this->getOffset(Element);
       }
 
       /** set elements */
       void setValue(const ElementEnum Element, const Vector Value)
       {
-        _Data.at(Element) = Value;
+        if (!this->checkElementSafe(Element))
+        {
+          return;
+        }
+
+        /** the layout is fixed, so the size has to match */
+        if (Value.size() != this->getLength(Element))
+        {
+          PRINT_ERROR("Wrong size of element ", static_cast<int>(Element), ": ", Value.size(), " instead of ", this->getLength(Element));
+          return;
+        }
+
+        _Data.segment(this->getOffset(Element), this->getLength(Element)) = Value;
       }
 
       void setValueScalar(const ElementEnum Element, const double Value)
       {
-        _Data.at(Element).fill(Value);
+        if (this->checkElementSafe(Element))
+        {
+          _Data.segment(this->getOffset(Element), this->getLength(Element)).fill(Value);
+        }
+      }
+
+      /** raw access to the whole buffer, that is ordered like the configuration */
+      Index getBufferSize() const
+      {
+        return _Data.size();
+      }
+
+      double* getBufferPointer()
+      {
+        return _Data.data();
+      }
+
+      const double* getBufferPointer() const
+      {
+        return _Data.data();
       }
 
       /** check if element exists */
       bool checkElement(const ElementEnum Element) const
       {
-        return (_Data.count(Element) > 0);
+        const int ElementIndex = static_cast<int>(Element);
+        return (_Layout != nullptr &&
+                ElementIndex < static_cast<int>(_Layout->Offset.size()) &&
+                _Layout->Offset[ElementIndex] >= 0);
       }
 
       /** generate pretty output strings */
       std::string getValueString() const
       {
         std::string Out;
+        this->appendValueString(Out);
+        return Out;
+      }
 
-        for(const auto &Element : _Config->getConfig(_Type))
+      /** append to an existing buffer, the values are ordered like the configuration */
+      void appendValueString(std::string &Out) const
+      {
+        char Buffer[32];
+        for(Index nElement = 0; nElement < _Data.size(); nElement++)
         {
-          for(Index nElement = 0; nElement < _Data.at(Element.first).size(); nElement++)
-          {
-            std::ostringstream Stream;
-            Stream.precision(8);
-            Stream << std::scientific << _Data.at(Element.first).operator[](nElement);
-
-            Out.append(Stream.str());
-            Out.append(" ");
-          }
+          const std::to_chars_result Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), _Data[nElement], std::chars_format::scientific, 8);
+          Out.append(Buffer, Result.ptr);
+          Out.push_back(' ');
         }
-
-        return Out;
       }
 
       std::string getNameValueString() const
       {
         std::string Out;
-        Out.append(_Name);
+        Out.append(this->getName());
         Out.append(": ");
 
-        for(auto const &Element : _Data)
+        /** print in order of the element enum */
+        for(int ElementIndex = 0; _Layout != nullptr && ElementIndex < static_cast<int>(_Layout->Offset.size()); ElementIndex++)
         {
+          if (_Layout->Offset[ElementIndex] < 0)
+          {
+            continue;
+          }
+
           Out.append(" ");
 
-          for(Index nElement = 0; nElement < Element.second.size(); nElement++)
+          for(int nElement = 0; nElement < _Layout->Length[ElementIndex]; nElement++)
           {
-            Out.append(std::to_string(Element.second.operator[](nElement)));
+            Out.append(std::to_string(_Data[_Layout->Offset[ElementIndex] + nElement]));
             Out.append(" ");
           }
         }
@@ -138,15 +192,10 @@ namespace libRSF
         if(_Config->checkType(Type))
         {
           _Type = Type;
-          _Name = _Config->getName(Type);
-
-          for(const auto &Element : _Config->getConfig(Type))
-          {
-            _Data.emplace(Element.first, Vector(Element.second));
-            _Data.at(Element.first).fill(0.0);
-          }
+          _Layout = &_Config->getLayout(Type);
 
-          _Data[ElementEnum::Timestamp].operator[](0) = Timestamp;
+          _Data.setZero(_Layout->Size);
+          this->setValueScalar(ElementEnum::Timestamp, Timestamp);
         }
         else
         {
@@ -154,21 +203,38 @@ namespace libRSF
         }
       }
 
-      void constructFromString(std::string Input)
+      bool constructFromString(std::string_view Input)
       {
+        const char* Current = Input.data();
+        const char* const End = Input.data() + Input.size();
+
         /** read type from string */
-        auto Split = Input.find_first_of(' ');
-        std::string Name = Input.substr(0, Split);
+        Current = SkipWhitespace(Current, End);
+        const char* NameEnd = Current;
+        while (NameEnd < End && *NameEnd != ' ' && *NameEnd != '\t')
+        {
+          NameEnd++;
+        }
+        const std::string_view Name(Current, NameEnd - Current);
 
         /** choose config according to type */
-        if(_Config->checkName(Name))
+        TypeEnum Type;
+        if(_Config->findType(Name, Type))
         {
-          constructEmpty(_Config->getType(Name));
-          parseSubstring(Input.substr(Split));
+          constructEmpty(Type);
+          if (parseValues(NameEnd, End) == false)
+          {
+            /** leave an invalid object */
+            _Layout = nullptr;
+            _Data.resize(0);
+            return false;
+          }
+          return true;
         }
         else
         {
           PRINT_ERROR("Type does not exist: ", Name);
+          return false;
         }
       }
 
@@ -176,32 +242,70 @@ namespace libRSF
     const ConfigType * _Config;
 
     private:
-      /** parse an ASCII input string */
-      std::string parseSubstring(std::string Input)
+      /** parse ASCII values directly into the buffer */
+      bool parseValues(const char* Current, const char* const End)
       {
-        size_t StringEnd = 0;
-        size_t InputStringEnd = 0;
-
-        for(const auto &Element : _Config->getConfig(_Type))
+        /** the buffer is ordered like the configuration */
+        for(Index nElement = 0; nElement < _Data.size(); nElement++)
         {
-          for(Index nElement = 0; nElement < _Data.at(Element.first).size(); nElement++)
+          Current = SkipWhitespace(Current, End);
+
+          /** from_chars does not accept a leading plus sign */
+          if (Current < End && *Current == '+')
+          {
+            Current++;
+          }
+
+          const std::from_chars_result Result = std::from_chars(Current, End, _Data[nElement]);
+          if (Result.ec != std::errc())
           {
-            _Data.at(Element.first).operator[](nElement) = std::stod(Input.substr(InputStringEnd), &StringEnd);
-            InputStringEnd += StringEnd;
+            PRINT_ERROR("Could not parse value ", nElement, " of type ", this->getName());
+            return false;
           }
+          Current = Result.ptr;
         }
 
-        return Input.substr(InputStringEnd);
+        return true;
       }
 
-      /** identifying string */
-      std::string _Name;
+      static const char* SkipWhitespace(const char* Current, const char* const End)
+      {
+        while (Current < End && (*Current == ' ' || *Current == '\t' || *Current == '\r'))
+        {
+          Current++;
+        }
+        return Current;
+      }
+
+      /** access the precomputed layout */
+      bool checkElementSafe(const ElementEnum Element) const
+      {
+        if (!this->checkElement(Element))
+        {
+          PRINT_ERROR("Element does not exist: ", static_cast<int>(Element));
+          return false;
+        }
+        return true;
+      }
+
+      int getOffset(const ElementEnum Element) const
+      {
+        return _Layout->Offset[static_cast<int>(Element)];
+      }
+
+      int getLength(const ElementEnum Element) const
+      {
+        return _Layout->Length[static_cast<int>(Element)];
+      }
 
       /** internal type */
       TypeEnum _Type;
 
-      /** where the data is stored */
-      std::map<ElementEnum, Vector> _Data;
+      /** offset and length of each element, shared by all objects of one type */
+      const LayoutType * _Layout = nullptr;
+
+      /** where the data is stored, all elements in one contiguous buffer */
+      Vector _Data;
   };
 }
 
@@ -36,6 +36,9 @@
 #include "Constants.h"
 #include "DataStream.h"
 
+#include <functional>
+#include <limits>
+
 namespace libRSF
 {
   /** one class as base for all lists of something in time */
@@ -64,11 +67,27 @@ namespace libRSF
         }
 
         KeyType ID;
-        double Timestamp;
+        Tick Timestamp;
         int Number;
       };
       typedef UniqueID ID;
 
+      /** callback that receives elements before they are evicted, e.g. to write them to disk */
+      typedef std::function<void(const KeyType &ID, const double Timestamp, const ObjectType &Object)> SpillCallback;
+
+      /** limits the memory of long running applications */
+      struct RetentionPolicy
+      {
+        /** elements older than the newest timestamp minus this age are evicted */
+        double MaxAge = std::numeric_limits<double>::infinity();
+
+        /** maximum number of elements per key up to the current time, zero is unlimited */
+        int MaxCount = 0;
+
+        /** optional, is called for every evicted element in time order */
+        SpillCallback Spill;
+      };
+
       /** add an element according to its ID and Timestamp*/
       void addElement(const KeyType &ID, const double &Timestamp, const ObjectType &Object)
       {
@@ -81,42 +100,186 @@ namespace libRSF
         _DataStreams.at(ID).emplace(Timestamp, Object);
       }
 
+      /** add multiple elements with the same ID and Timestamp, keeps their order */
+      void addElements(const KeyType &ID, const double &Timestamp, const std::vector<ObjectType> &Objects)
+      {
+        ObjectStream &Stream = _DataStreams[ID];
+        for (const ObjectType &Object : Objects)
+        {
+          Stream.emplace(Timestamp, Object);
+        }
+      }
+
+      /** add an element that is not older than the existing ones of this ID, skips the search in the stream */
+      void appendElement(const KeyType &ID, const double &Timestamp, const ObjectType &Object)
+      {
+        ObjectStream &Stream = _DataStreams[ID];
+        Stream.emplace_hint(Stream.end(), Timestamp, Object);
+      }
+
       void removeElement(const KeyType &ID, const double Timestamp, const int Number)
       {
-        if (this->checkElement(ID, Timestamp, Number))
+        const auto ItStream = _DataStreams.find(ID);
+        if (ItStream != _DataStreams.end())
         {
-          auto It = _DataStreams.at(ID).find(Timestamp);
-          std::advance(It, Number);
-          _DataStreams.at(ID).erase(It);
+          const auto Range = ItStream->second.equal_range(Timestamp);
+          if (std::distance(Range.first, Range.second) > Number)
+          {
+            ItStream->second.erase(std::next(Range.first, Number));
+
+            /** erase empty IDs */
+            if (ItStream->second.empty())
+            {
+              _DataStreams.erase(ItStream);
+            }
+            return;
+          }
+        }
+        PRINT_ERROR("Element doesn't exist at: ", Timestamp, " Type: ", ID, " Number: ", Number);
+      }
 
+      void removeElement(const KeyType &ID, const double Timestamp)
+      {
+        const auto ItStream = _DataStreams.find(ID);
+        if (ItStream != _DataStreams.end() && ItStream->second.erase(Timestamp) > 0)
+        {
           /** erase empty IDs */
-          if (_DataStreams.at(ID).empty())
+          if (ItStream->second.empty())
           {
-            _DataStreams.erase(ID);
+            _DataStreams.erase(ItStream);
           }
         }
         else
         {
-          PRINT_ERROR("Element doesn't exist at: ", Timestamp, " Type: ", ID, " Number: ", Number);
+          PRINT_ERROR("Element doesn't exist at: ", Timestamp, " Type: ", ID);
         }
       }
 
-      void removeElement(const KeyType &ID, const double Timestamp)
+      /** remove all elements of one ID before a timestamp at once, returns the number of removed elements */
+      int removeElementsBefore(const KeyType &ID, const double Timestamp)
+      {
+        const auto ItStream = _DataStreams.find(ID);
+        if (ItStream == _DataStreams.end())
+        {
+          return 0;
+        }
+
+        const int Removed = this->evictFront(ItStream, ItStream->second.lower_bound(Timestamp), false);
+
+        /** erase empty IDs */
+        if (ItStream->second.empty())
+        {
+          _DataStreams.erase(ItStream);
+        }
+        return Removed;
+      }
+
+      /** same as above, but including the timestamp itself */
+      int removeElementsBeforeOrEqual(const KeyType &ID, const double Timestamp)
+      {
+        const auto ItStream = _DataStreams.find(ID);
+        if (ItStream == _DataStreams.end())
+        {
+          return 0;
+        }
+
+        const int Removed = this->evictFront(ItStream, ItStream->second.upper_bound(Timestamp), false);
+
+        /** erase empty IDs */
+        if (ItStream->second.empty())
+        {
+          _DataStreams.erase(ItStream);
+        }
+        return Removed;
+      }
+
+      /** remove all elements before a timestamp, returns the number of removed elements */
+      int removeElementsBefore(const double Timestamp)
+      {
+        int Removed = 0;
+        for (const KeyType &ID : this->getKeysAll())
+        {
+          Removed += this->removeElementsBefore(ID, Timestamp);
+        }
+        return Removed;
+      }
+
+      /** bounded memory for long running applications */
+      void setRetentionPolicy(const RetentionPolicy &Policy)
+      {
+        _Policy = Policy;
+      }
+
+      const RetentionPolicy& getRetentionPolicy() const
+      {
+        return _Policy;
+      }
+
+      /** evict everything that violates the retention policy, relative to the given time
+       *  returns the number of evicted elements */
+      int applyRetentionPolicy(const double TimeNow)
       {
-        if (checkElement(ID, Timestamp))
+        const bool LimitAge = std::isfinite(_Policy.MaxAge);
+        const bool LimitCount = _Policy.MaxCount > 0;
+
+        if (!LimitAge && !LimitCount)
+        {
+          return 0;
+        }
+
+        int Removed = 0;
+        for (auto ItStream = _DataStreams.begin(); ItStream != _DataStreams.end();)
         {
-          _DataStreams.at(ID).erase(Timestamp);
+          ObjectStream &Stream = ItStream->second;
+
+          /** everything before this iterator expires, elements after TimeNow are never touched */
+          const auto Now = Stream.upper_bound(TimeNow);
+          auto End = Stream.begin();
+          if (LimitAge)
+          {
+            End = Stream.lower_bound(TimeNow - _Policy.MaxAge);
+          }
+          if (LimitCount)
+          {
+            /** only elements up to TimeNow count, future ones are e.g. preloaded measurements */
+            const int Count = static_cast<int>(std::distance(End, Now));
+            if (Count > _Policy.MaxCount)
+            {
+              std::advance(End, Count - _Policy.MaxCount);
+            }
+          }
+
+          Removed += this->evictFront(ItStream, End, true);
 
           /** erase empty IDs */
-          if (_DataStreams.at(ID).empty())
+          if (Stream.empty())
+          {
+            ItStream = _DataStreams.erase(ItStream);
+          }
+          else
           {
-            _DataStreams.erase(ID);
+            ++ItStream;
           }
         }
-        else
+
+        return Removed;
+      }
+
+      /** same as above, but relative to the newest stored element */
+      int applyRetentionPolicy()
+      {
+        if (_DataStreams.empty())
         {
-          PRINT_ERROR("Element doesn't exist at: ", Timestamp, " Type: ", ID);
+          return 0;
         }
+
+        double TimeNow = -std::numeric_limits<double>::infinity();
+        for (const auto &Stream : _DataStreams)
+        {
+          TimeNow = std::max<double>(TimeNow, std::prev(Stream.second.end())->first);
+        }
+
+        return this->applyRetentionPolicy(TimeNow);
       }
 
       void clear()
@@ -261,6 +424,29 @@ namespace libRSF
         }
       }
 
+      bool getTimeLastOverall(double& Timestamp) const
+      {
+        if(_DataStreams.empty() == true)
+        {
+          PRINT_ERROR("Empty list!");
+          return false;
+        }
+
+        double TimeLast = Timestamp;
+        Timestamp = NAN_DOUBLE;
+        std::vector<KeyType> IDs = this->getKeysAll();
+        for(const KeyType &ID: IDs)
+        {
+          this->getTimeLast(ID, TimeLast);
+          if(std::isnan(Timestamp) == true || TimeLast > Timestamp)
+          {
+            Timestamp = TimeLast;
+          }
+        }
+
+        return true;
+      }
+
       bool getTimeNext(const KeyType &ID, const double Timestamp, double& NextTimeStamp) const
       {
         if(this->checkElement(ID, Timestamp))
@@ -528,6 +714,27 @@ namespace libRSF
         return Objects;
       }
 
+      /** read-only access to the time-ordered stream of one ID, without copying the objects */
+      const ObjectStream* getStream(const KeyType &ID) const
+      {
+        const auto It = _DataStreams.find(ID);
+        if (It == _DataStreams.end())
+        {
+          return nullptr;
+        }
+        return &It->second;
+      }
+
+      ObjectStream* getStream(const KeyType &ID)
+      {
+        const auto It = _DataStreams.find(ID);
+        if (It == _DataStreams.end())
+        {
+          return nullptr;
+        }
+        return &It->second;
+      }
+
       std::vector<ObjectType> getElements(const KeyType &ID, const double Timestamp) const
       {
         std::vector<ObjectType> Objects;
@@ -734,7 +941,7 @@ namespace libRSF
       {
         for (auto& Map: List)
         {
-          for (auto& Element: Map.second)
+          for (const auto& Element: Map.second)
           {
             this->addElement(Map.first, Element.first, Element.second);
           }
@@ -742,6 +949,27 @@ namespace libRSF
       }
 
     protected:
+      /** erase the front of one stream in a single operation, the spill callback can get the elements before */
+      int evictFront(const typename std::map<KeyType, ObjectStream>::iterator ItStream, const typename ObjectStream::iterator End, const bool Spill)
+      {
+        ObjectStream &Stream = ItStream->second;
+        const int Removed = static_cast<int>(std::distance(Stream.begin(), End));
+
+        if (Removed > 0)
+        {
+          if (Spill && _Policy.Spill)
+          {
+            for (auto It = Stream.begin(); It != End; ++It)
+            {
+              _Policy.Spill(ItStream->first, It->first, It->second);
+            }
+          }
+          Stream.erase(Stream.begin(), End);
+        }
+
+        return Removed;
+      }
+
       bool _FindBordersEqual(const KeyType &ID, const double Start, const double End, double &StartTrue, double &EndTrue) const
       {
         if(Start > End)
@@ -788,6 +1016,9 @@ namespace libRSF
 
       std::map<KeyType, ObjectStream> _DataStreams;
 
+      /** unlimited by default */
+      RetentionPolicy _Policy;
+
       /** for empty references */
       ObjectType NullObject;
   };
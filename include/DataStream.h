@@ -32,79 +32,96 @@
 #ifndef DATASTREAM_H
 #define DATASTREAM_H
 
+#include "Tick.h"
+
 #include <map>
-#include <cmath>
+#include <deque>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
 
 namespace libRSF
 {
   /** round the timestamp to ticks-precision */
   double roundToTick(const double Time);
 
-  /** stream of objects with ticked timestamps */
+  /** stream of objects with ticked timestamps, based on a red-black tree */
   template<typename ObjectType>
-  class DataStream : private std::multimap<double, ObjectType>
+  class DataStreamTree : private std::multimap<Tick, ObjectType>
   {
     public:
-      DataStream() = default;
-      virtual ~DataStream() = default;
+      DataStreamTree() = default;
+      virtual ~DataStreamTree() = default;
 
       /** define base class */
-      typedef typename std::multimap<double, ObjectType> BaseClass;
+      typedef typename std::multimap<Tick, ObjectType> BaseClass;
 
       /** use the types of the base class */
       typedef typename BaseClass::iterator iterator;
       typedef typename BaseClass::const_iterator const_iterator;
       typedef typename BaseClass::size_type size_type;
 
-      /** implement all functions with a fixed tick size for the double keys */
+      /** implement all functions with integer tick keys */
       iterator find (const double &Time)
       {
-        return BaseClass::find(roundToTick(Time));
+        return BaseClass::find(Tick(Time));
       }
 
       const_iterator find (const double &Time) const
       {
-        return BaseClass::find(roundToTick(Time));
+        return BaseClass::find(Tick(Time));
       }
 
       size_type count (const double &Time) const
       {
-        return BaseClass::count(roundToTick(Time));
+        return BaseClass::count(Tick(Time));
       }
 
       iterator lower_bound (const double &Time)
       {
-        return BaseClass::lower_bound(roundToTick(Time));
+        return BaseClass::lower_bound(Tick(Time));
       }
 
       const_iterator lower_bound (const double &Time) const
       {
-        return BaseClass::lower_bound(roundToTick(Time));
+        return BaseClass::lower_bound(Tick(Time));
       }
 
       iterator upper_bound (const double &Time)
       {
-        return BaseClass::upper_bound(roundToTick(Time));
+        return BaseClass::upper_bound(Tick(Time));
       }
 
       const_iterator upper_bound (const double &Time) const
       {
-        return BaseClass::upper_bound(roundToTick(Time));
+        return BaseClass::upper_bound(Tick(Time));
       }
 
       std::pair<iterator,iterator> equal_range (const double &Time)
       {
-        return BaseClass::equal_range(roundToTick(Time));
+        return BaseClass::equal_range(Tick(Time));
       }
 
       std::pair<const_iterator,const_iterator> equal_range (const double &Time) const
       {
-        return BaseClass::equal_range(roundToTick(Time));
+        return BaseClass::equal_range(Tick(Time));
       }
 
       iterator emplace (const double &Time, const ObjectType &Object)
       {
-        return BaseClass::emplace(roundToTick(Time), Object);
+        return BaseClass::emplace(Tick(Time), Object);
+      }
+
+      /** constant time if the element belongs directly before the hint, e.g. end() for sorted input */
+      iterator emplace_hint (const_iterator Hint, const double &Time, const ObjectType &Object)
+      {
+        return BaseClass::emplace_hint(Hint, Tick(Time), Object);
+      }
+
+      size_type erase (const double &Time)
+      {
+        return BaseClass::erase(Tick(Time));
       }
 
       /** expose other functions */
@@ -114,6 +131,395 @@ namespace libRSF
       using BaseClass::size;
       using BaseClass::empty;
   };
+
+  /** stream of objects with ticked timestamps, based on a sorted index and a slot storage
+   *
+   * The keys are stored as integer ticks in a sorted deque, so lookups are binary searches and appending or removing
+   * at the front/back is O(1). The objects itself are stored in a separate deque and never move after insertion, so
+   * raw pointers (like the ones ceres holds to the states) stay valid until the object is erased.
+   * Free slots are reused, free slots at both ends of the storage are released, so a sliding window does not grow it. */
+  template<typename ObjectType>
+  class DataStreamContiguous
+  {
+    private:
+      struct IndexEntry
+      {
+        Tick Key;
+        ObjectType* Object;
+        size_t Slot;
+      };
+
+      typedef std::deque<IndexEntry> IndexType;
+
+      /** iterator that behaves like the one of std::multimap */
+      template <bool IsConst>
+      class Iterator
+      {
+        public:
+          typedef std::conditional_t<IsConst, const ObjectType, ObjectType> Object;
+
+          typedef std::bidirectional_iterator_tag iterator_category;
+          typedef std::pair<const Tick, Object&> value_type;
+          typedef std::ptrdiff_t difference_type;
+          typedef value_type reference;
+
+          /** required to support "It->first" and "It->second" */
+          struct pointer
+          {
+            value_type Pair;
+            const value_type* operator->() const
+            {
+              return &Pair;
+            }
+          };
+
+          Iterator() = default;
+          explicit Iterator(typename IndexType::const_iterator Position) : _Position(Position) {}
+
+          /** allow conversion from iterator to const_iterator */
+          template <bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+          Iterator(const Iterator<OtherIsConst> &Other) : _Position(Other._Position) {}
+
+          reference operator* () const
+          {
+            return value_type(_Position->Key, *_Position->Object);
+          }
+
+          pointer operator-> () const
+          {
+            return pointer{**this};
+          }
+
+          Iterator& operator++ ()
+          {
+            ++_Position;
+            return *this;
+          }
+
+          Iterator operator++ (int)
+          {
+            Iterator Old = *this;
+            ++_Position;
+            return Old;
+          }
+
+          Iterator& operator-- ()
+          {
+            --_Position;
+            return *this;
+          }
+
+          Iterator operator-- (int)
+          {
+            Iterator Old = *this;
+            --_Position;
+            return Old;
+          }
+
+          bool operator == (const Iterator &Other) const
+          {
+            return _Position == Other._Position;
+          }
+
+          bool operator != (const Iterator &Other) const
+          {
+            return _Position != Other._Position;
+          }
+
+        private:
+          friend class DataStreamContiguous;
+          template <bool> friend class Iterator;
+
+          typename IndexType::const_iterator _Position;
+      };
+
+    public:
+      typedef Iterator<false> iterator;
+      typedef Iterator<true> const_iterator;
+      typedef size_t size_type;
+
+      DataStreamContiguous() = default;
+      virtual ~DataStreamContiguous() = default;
+
+      /** the index points into the own storage, so copies have to be rebuilt */
+      DataStreamContiguous(const DataStreamContiguous &Other)
+      {
+        this->copyFrom(Other);
+      }
+
+      DataStreamContiguous& operator = (const DataStreamContiguous &Other)
+      {
+        if (this != &Other)
+        {
+          this->clear();
+          this->copyFrom(Other);
+        }
+        return *this;
+      }
+
+      /** moving a std::deque keeps the addresses of its elements */
+      DataStreamContiguous(DataStreamContiguous &&Other) = default;
+      DataStreamContiguous& operator = (DataStreamContiguous &&Other) = default;
+
+      iterator find (const double &Time)
+      {
+        return iterator(this->findIndex(Tick(Time)));
+      }
+
+      const_iterator find (const double &Time) const
+      {
+        return const_iterator(this->findIndex(Tick(Time)));
+      }
+
+      size_type count (const double &Time) const
+      {
+        const auto Range = this->equalRangeIndex(Tick(Time));
+        return static_cast<size_type>(std::distance(Range.first, Range.second));
+      }
+
+      iterator lower_bound (const double &Time)
+      {
+        return iterator(this->lowerBoundIndex(Tick(Time)));
+      }
+
+      const_iterator lower_bound (const double &Time) const
+      {
+        return const_iterator(this->lowerBoundIndex(Tick(Time)));
+      }
+
+      iterator upper_bound (const double &Time)
+      {
+        return iterator(this->upperBoundIndex(Tick(Time)));
+      }
+
+      const_iterator upper_bound (const double &Time) const
+      {
+        return const_iterator(this->upperBoundIndex(Tick(Time)));
+      }
+
+      std::pair<iterator,iterator> equal_range (const double &Time)
+      {
+        const auto Range = this->equalRangeIndex(Tick(Time));
+        return std::make_pair(iterator(Range.first), iterator(Range.second));
+      }
+
+      std::pair<const_iterator,const_iterator> equal_range (const double &Time) const
+      {
+        const auto Range = this->equalRangeIndex(Tick(Time));
+        return std::make_pair(const_iterator(Range.first), const_iterator(Range.second));
+      }
+
+      iterator emplace (const double &Time, const ObjectType &Object)
+      {
+        const Tick Key(Time);
+
+        /** store the object in a free slot or append it */
+        size_t Slot;
+        if (_FreeSlots.empty())
+        {
+          Slot = _FirstSlot + _Storage.size();
+          _Storage.push_back(Object);
+          _Free.push_back(false);
+        }
+        else
+        {
+          Slot = _FreeSlots.back();
+          _FreeSlots.pop_back();
+          _Storage[Slot - _FirstSlot] = Object;
+          _Free[Slot - _FirstSlot] = false;
+        }
+        const IndexEntry Entry = {Key, &_Storage[Slot - _FirstSlot], Slot};
+
+        /** like std::multimap, new elements are inserted behind existing ones with the same key */
+        if (_Index.empty() || _Index.back().Key <= Key)
+        {
+          _Index.push_back(Entry);
+          return iterator(std::prev(_Index.cend()));
+        }
+        else if (_Index.front().Key > Key)
+        {
+          _Index.push_front(Entry);
+          return iterator(_Index.cbegin());
+        }
+
+        return iterator(_Index.insert(this->upperBoundIndex(Key), Entry));
+      }
+
+      /** appending is already constant time, so the hint is not needed */
+      iterator emplace_hint (const_iterator Hint, const double &Time, const ObjectType &Object)
+      {
+        static_cast<void>(Hint);
+        return this->emplace(Time, Object);
+      }
+
+      iterator erase (const_iterator Position)
+      {
+        this->releaseSlot(Position._Position->Slot);
+
+        /** removing the first or last element of a deque does not move the others */
+        if (Position._Position == _Index.cbegin())
+        {
+          _Index.pop_front();
+          return this->finalizeErase(_Index.cbegin());
+        }
+
+        return this->finalizeErase(_Index.erase(Position._Position));
+      }
+
+      iterator erase (const_iterator First, const_iterator Last)
+      {
+        for (auto It = First._Position; It != Last._Position; ++It)
+        {
+          this->releaseSlot(It->Slot);
+        }
+
+        return this->finalizeErase(_Index.erase(First._Position, Last._Position));
+      }
+
+      size_type erase (const double &Time)
+      {
+        const auto Range = this->equalRangeIndex(Tick(Time));
+        const size_type Count = static_cast<size_type>(std::distance(Range.first, Range.second));
+        this->erase(const_iterator(Range.first), const_iterator(Range.second));
+        return Count;
+      }
+
+      void clear()
+      {
+        _Index.clear();
+        _Storage.clear();
+        _Free.clear();
+        _FreeSlots.clear();
+        _FirstSlot = 0;
+      }
+
+      iterator begin()
+      {
+        return iterator(_Index.cbegin());
+      }
+
+      const_iterator begin() const
+      {
+        return const_iterator(_Index.cbegin());
+      }
+
+      iterator end()
+      {
+        return iterator(_Index.cend());
+      }
+
+      const_iterator end() const
+      {
+        return const_iterator(_Index.cend());
+      }
+
+      size_type size() const
+      {
+        return _Index.size();
+      }
+
+      bool empty() const
+      {
+        return _Index.empty();
+      }
+
+      /** number of allocated slots, including free ones */
+      size_type storageSize() const
+      {
+        return _Storage.size();
+      }
+
+    private:
+      typename IndexType::const_iterator lowerBoundIndex(const Tick Key) const
+      {
+        return std::lower_bound(_Index.cbegin(), _Index.cend(), Key,
+                                [](const IndexEntry &Entry, const Tick Value){return Entry.Key < Value;});
+      }
+
+      typename IndexType::const_iterator upperBoundIndex(const Tick Key) const
+      {
+        return std::upper_bound(_Index.cbegin(), _Index.cend(), Key,
+                                [](const Tick Value, const IndexEntry &Entry){return Value < Entry.Key;});
+      }
+
+      std::pair<typename IndexType::const_iterator, typename IndexType::const_iterator> equalRangeIndex(const Tick Key) const
+      {
+        return std::make_pair(this->lowerBoundIndex(Key), this->upperBoundIndex(Key));
+      }
+
+      typename IndexType::const_iterator findIndex(const Tick Key) const
+      {
+        const auto It = this->lowerBoundIndex(Key);
+        if (It != _Index.cend() && It->Key == Key)
+        {
+          return It;
+        }
+        return _Index.cend();
+      }
+
+      void releaseSlot(const size_t Slot)
+      {
+        /** free the memory of the object, but keep its slot for the next one */
+        _Storage[Slot - _FirstSlot] = ObjectType();
+        _Free[Slot - _FirstSlot] = true;
+        _FreeSlots.push_back(Slot);
+      }
+
+      iterator finalizeErase(typename IndexType::const_iterator Next)
+      {
+        /** removing at both ends of a deque does not move the other objects */
+        const size_t Size = _Storage.size();
+        while (_Free.empty() == false && _Free.front())
+        {
+          _Storage.pop_front();
+          _Free.pop_front();
+          _FirstSlot++;
+        }
+        while (_Free.empty() == false && _Free.back())
+        {
+          _Storage.pop_back();
+          _Free.pop_back();
+        }
+
+        /** forget the released slots */
+        if (_Storage.size() < Size)
+        {
+          const size_t EndSlot = _FirstSlot + _Storage.size();
+          _FreeSlots.erase(std::remove_if(_FreeSlots.begin(), _FreeSlots.end(), [this, EndSlot](const size_t Slot)
+          {
+            return Slot < _FirstSlot || Slot >= EndSlot;
+          }), _FreeSlots.end());
+        }
+
+        return _Index.empty() ? this->end() : iterator(Next);
+      }
+
+      void copyFrom(const DataStreamContiguous &Other)
+      {
+        /** store a compact copy */
+        for (const IndexEntry &Entry : Other._Index)
+        {
+          _Storage.push_back(*Entry.Object);
+          _Free.push_back(false);
+          _Index.push_back({Entry.Key, &_Storage.back(), _FirstSlot + _Storage.size() - 1});
+        }
+      }
+
+      IndexType _Index;
+      std::deque<ObjectType> _Storage;
+      std::deque<bool> _Free;
+      std::vector<size_t> _FreeSlots;
+      size_t _FirstSlot = 0;
+  };
+
+  /** select the storage backend at compile time */
+#ifdef LIBRSF_CONTIGUOUS_DATASTREAM
+  template<typename ObjectType>
+  using DataStream = DataStreamContiguous<ObjectType>;
+#else
+  template<typename ObjectType>
+  using DataStream = DataStreamTree<ObjectType>;
+#endif
 }
 
 #endif // DATASTREAM_H
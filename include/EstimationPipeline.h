@@ -0,0 +1,108 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file EstimationPipeline.h
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Generic estimation loop that is configured by the solution part of FactorGraphConfig.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef ESTIMATIONPIPELINE_H
+#define ESTIMATIONPIPELINE_H
+
+#include "FactorGraph.h"
+#include "FactorGraphConfig.h"
+#include "SensorDataSet.h"
+#include "StateDataSet.h"
+#include "TimeMeasurement.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace libRSF
+{
+  /** runs the loop over all epochs that every application needs
+   *
+   * The application only adds the states and factors of one epoch and stores its result. Synchronization, solving,
+   * sliding window or marginalization, covariance estimation and timing are handled here according to the config.
+   * The retention policies of the measurements and the result are applied after each epoch. */
+  class EstimationPipeline
+  {
+    public:
+      /** add states and factors of one epoch, for the first epoch TimeOld equals TimeNow */
+      typedef std::function<void(FactorGraph &Graph, SensorDataSet &Measurements, const double TimeOld, const double TimeNow)> EpochFunction;
+
+      /** store the estimate of one epoch after it is solved */
+      typedef std::function<void(FactorGraph &Graph, const double TimeNow, StateDataSet &Result)> ResultFunction;
+
+      EstimationPipeline(const FactorGraphConfig &Config, EpochFunction AddEpoch, ResultFunction SaveResult);
+      virtual ~EstimationPipeline() = default;
+
+      /** covariances of these states are estimated, if EstimateCov is set */
+      void setCovarianceStates(const std::vector<string> &Names, const int Interval = 1);
+
+      /** process all epochs of the measurements */
+      bool run(FactorGraph &Graph, SensorDataSet &Measurements, StateDataSet &Result);
+
+      /** process all epochs after an epoch that was already initialized and solved by the caller */
+      bool run(FactorGraph &Graph, SensorDataSet &Measurements, const double TimeInitialized, StateDataSet &Result);
+
+      /** runtime of each epoch as IterationSummary */
+      const StateDataSet& getTiming() const;
+
+      static const string TimingName;
+
+    private:
+      /** the actual loop */
+      bool process(FactorGraph &Graph, SensorDataSet &Measurements, const std::vector<double> &Epochs, double TimeOld, StateDataSet &Result);
+
+      /** compute the timestamps of all epochs */
+      bool getEpochs(const SensorDataSet &Measurements, std::vector<double> &Epochs) const;
+
+      /** configure the graph according to the solution type */
+      void prepareGraph(FactorGraph &Graph) const;
+
+      /** post processing of a solved epoch */
+      void applyWindow(FactorGraph &Graph, const double TimeOld, const double TimeNow) const;
+      void estimateCovariance(FactorGraph &Graph, const double TimeNow, const int Epoch) const;
+      void storeTiming(FactorGraph &Graph, const double TimeNow, Timer &EpochTimer);
+
+      const FactorGraphConfig::GraphConfig _Solution;
+      const ceres::Solver::Options _SolverOptions;
+
+      EpochFunction _AddEpoch;
+      ResultFunction _SaveResult;
+
+      std::vector<string> _CovarianceStates;
+      int _CovarianceInterval;
+
+      StateDataSet _Timing;
+  };
+}
+
+#endif // ESTIMATIONPIPELINE_H
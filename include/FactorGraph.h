@@ -40,6 +40,7 @@
 #include "DataSet.h"
 #include "LocalParametrization.h"
 #include "Marginalization.h"
+#include "MemoryPool.h"
 #include "StateDataSet.h"
 #include "SensorDataSet.h"
 #include "Types.h"
@@ -50,6 +51,7 @@
 #include "error_models/MaxMixture.h"
 #include "error_models/SumMixture.h"
 #include "error_models/MaxSumMixture.h"
+#include "error_models/SharedErrorModel.h"
 #include "error_models/LossFunction.h"
 #include "error_models/SwitchableConstraints.h"
 #include "error_models/DynamicCovarianceEstimation.h"
@@ -78,7 +80,16 @@
 #include <ceres/ceres.h>
 #include <ceres/normal_prior.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <unordered_set>
 
 namespace libRSF
 {
@@ -97,7 +108,7 @@ namespace libRSF
       /** Default constructor */
       FactorGraph();
       /** Default destructor */
-      virtual ~FactorGraph() = default;
+      virtual ~FactorGraph();
 
       /** access to single states */
       void addState(string Name, DataType Type, double Timestamp);
@@ -125,6 +136,7 @@ namespace libRSF
         {
           *static_cast<ErrorType*>(ErrorModel) = NoiseModel;
         }
+        _Modified = true;
       }
       /** replace error model of all factors of a specific type */
       template <typename ErrorType>
@@ -145,7 +157,10 @@ namespace libRSF
         /** find the right error model pointer */
         ErrorModelBase* ModelPointer;
         FactorID ID(CurrentFactorType, TimeStamp, Number);
-        _Structure.getErrorModel(ID, ModelPointer);
+        if (_Structure.getErrorModel(ID, ModelPointer) == false)
+        {
+          return;
+        }
 
         /** replace */
         std::vector<ErrorModelBase*> ModelPoiters = {ModelPointer};
@@ -195,6 +210,33 @@ namespace libRSF
         addFactorBase<CurrentFactorType>(List, NoiseModel, Measurement, RobustLoss);
       }
 
+      /** add multiple factors of one type that share the same states, e.g. all pseudoranges of one epoch
+       *  states are resolved once and the graph structure is updated in a single step
+       *  the robust loss (if any) is shared by all factors of the batch */
+      template <FactorType CurrentFactorType, typename ErrorType>
+      void addFactors(const StateList &List,
+                      const std::vector<Data> &Measurements,
+                      ErrorType &NoiseModel,
+                      ceres::LossFunction* RobustLoss = nullptr)
+      {
+        addFactorsBase<CurrentFactorType, ErrorType>(List, Measurements, [&NoiseModel](const size_t){return std::ref(NoiseModel);}, RobustLoss);
+      }
+
+      /** same as above, with an individual error model per measurement */
+      template <FactorType CurrentFactorType, typename ErrorType>
+      void addFactors(const StateList &List,
+                      const std::vector<Data> &Measurements,
+                      std::vector<ErrorType> &NoiseModels,
+                      ceres::LossFunction* RobustLoss = nullptr)
+      {
+        if (NoiseModels.size() != Measurements.size())
+        {
+          PRINT_ERROR("Number of error models ", NoiseModels.size(), " does not match the number of measurements ", Measurements.size());
+          return;
+        }
+        addFactorsBase<CurrentFactorType, ErrorType>(List, Measurements, [&NoiseModels](const size_t n){return std::ref(NoiseModels[n]);}, RobustLoss);
+      }
+
       /** special case for IMU pre-integration */
       void addIMUPreintegrationFactor(StateList List, PreintegratedIMUResult IMUState);
 
@@ -203,19 +245,61 @@ namespace libRSF
       void removeFactorsOutsideWindow(const FactorType CurrentFactorType, const double TimeWindow, const double CurrentTime);
       void removeAllFactorsOutsideWindow(const double TimeWindow, const double CurrentTime);
 
+      /** remove or marginalize everything that is older than the window in one pass */
+      void slideWindow(const double CurrentTime, const double TimeWindow, const WindowPolicy Policy = WindowPolicy::Remove, const double Inflation = 1.0);
+
       /** solve problem */
       void solve();
       void solve(ceres::Solver::Options Options);
 
+      /** incremental solving: states older than the active window are held constant,
+       *  with SkipUnchanged a solve after a converged one is skipped if neither the structure nor the error models or constant states
+       *  were changed through the graph, so it must not be used if states or error models are modified directly */
+      void setIncrementalMode(const bool Enable, const double ActiveWindow = std::numeric_limits<double>::infinity(), const bool SkipUnchanged = false);
+      const FactorGraphStructure::Changes& getChangesSinceSolve() const;
+
+      /** incremental smoother: only states that are connected to new factors are optimized,
+       *  the update is propagated to neighbors of states that moved more than the threshold
+       *  between updates all states are constant, so covariances and marginalization require to disable it first
+       *  the result is approximate: it matches a batch solve only if the propagation reaches all states that should move,
+       *  updates below the threshold or beyond MaxPropagationSteps are not passed on */
+      void setSmootherMode(const bool Enable, const double RelinearizationThreshold = 0.01, const int MaxPropagationSteps = 5);
+
+      /** solve problem in the background, a still running solve is returned instead of starting a new one
+       *  while the solver is running, the graph must only be modified with stage() and read with getStateSnapshot() */
+      std::shared_future<bool> solveAsync();
+      std::shared_future<bool> solveAsync(ceres::Solver::Options Options);
+      bool isSolving() const;
+      void waitForSolver();
+
+      /** modifications of the graph are applied immediately or at the next solve boundary, if the solver is running */
+      void stage(std::function<void(FactorGraph&)> Modification);
+
+      /** latest estimates of solveAsync(), the snapshot is replaced after each asynchronous solve and never modified
+       *  (nullptr before the first one), synchronous solves do not copy the states */
+      std::shared_ptr<const StateDataSet> getStateSnapshot() const;
+
       /** compute covariances */
       bool computeCovarianceSigmaPoints(const string Name, const double Timestamp, const int StateNumber = 0);
       bool computeCovariance(const string Name, const double Timestamp);
       bool computeCovariance(const string Name);
 
+      /** one factorization for many states, optionally with the joint covariance in the order of States */
+      bool computeCovariances(const std::vector<StateID> &States);
+      bool computeCovariances(const std::vector<StateID> &States, Matrix &JointCovariance);
+
+      /** covariance of the newest states only, all older states are eliminated recursively into a cached prior
+       *  assumes that new factors are connected to at least one state that was not part of the last call,
+       *  states of the last call can be passed again (e.g. a persistent bias), older factors are not relinearized,
+       *  the cache is reset if one of its states is removed or if the same states are requested after the graph changed */
+      bool computeCovariancesRecursive(const std::vector<StateID> &States);
+      void resetCovarianceCache();
+
       /** marginalize factors */
       bool marginalizeState(const string Name, const double Timestamp, const int Number = 0);
       bool marginalizeStates(std::vector<StateID> States, const double Inflation = 1.0);
       bool marginalizeAllStatesOutsideWindow(const double TimeWindow, const double CurrentTime, const double Inflation = 1.0);
+      void setMarginalizationType(const MarginalizationType Type);
 
       /** sample output state */
       void sampleCost1D(const string StateName,
@@ -257,7 +341,7 @@ namespace libRSF
       void getFactorsOfState(const string Name, const double Timestamp, const int Number, std::vector<FactorID> &Factors) const;
       int countFactorsOfType(const FactorType CurrentFactorType) const;
 
-      /** compute raw errors without error models */
+      /** compute raw errors without error models, the vector is overwritten and its memory is reused */
       void computeUnweightedError(const FactorType CurrentFactorType, std::vector<double> &ErrorData);
       void computeUnweightedErrorMatrix(const FactorType CurrentFactorType, Matrix &ErrorMatrix);
       void computeUnweightedError(const FactorType CurrentFactorType, const string &Name, StateDataSet &ErrorData);
@@ -273,6 +357,7 @@ namespace libRSF
       int getSolverIterationsAndReset();
       double getSolverDurationAndReset();
       double getMarginalDurationAndReset();
+      double getWindowDurationAndReset();
 
     private:
 
@@ -280,7 +365,7 @@ namespace libRSF
       template<int NoiseModelOutputDim, typename FactorClass,  int... FactorStateDims, int... ErrorModelStateDims>
       auto makeAutoDiffCostFunction(FactorClass *Factor, std::integer_sequence<int, FactorStateDims...>, std::integer_sequence<int, ErrorModelStateDims...>)
       {
-        return new ceres::AutoDiffCostFunction<FactorClass, NoiseModelOutputDim, FactorStateDims... , ErrorModelStateDims...> (Factor);
+        return new Pooled<ceres::AutoDiffCostFunction<FactorClass, NoiseModelOutputDim, FactorStateDims... , ErrorModelStateDims...>> (Factor);
       }
 
       /** add and remove factors */
@@ -305,6 +390,12 @@ namespace libRSF
         /** use the factor to predict */
         Factor->predict(StatePointers);
 
+        /** new shared models have to be pinned before the solve */
+        if constexpr (IsSharedErrorModel<ErrorType>::value)
+        {
+          this->registerSharedModel(Factor->getErrorModel()->getState());
+        }
+
         /** wrap it in ceres cost function */
         auto CostFunction = makeAutoDiffCostFunction<ErrorType::OutputDim, FactorClass> (Factor,
                                                                                          typename FactorClass::StateDims{},
@@ -386,16 +477,99 @@ namespace libRSF
         }
       }
 
+      template <FactorType CurrentFactorType, typename ErrorType, typename NoiseModelGetter>
+      void addFactorsBase(const StateList &States, const std::vector<Data> &Measurements, NoiseModelGetter GetNoiseModel, ceres::LossFunction* RobustLoss)
+      {
+        /** translate the factor type enum to the class that should be added to the graph */
+        typedef typename FactorTypeTranslator<CurrentFactorType,ErrorType>::Type FactorClassType;
+
+        static_assert(FactorClassType::HasMeasurement == true, "Only factors with measurements can be added as batch!");
+
+        if (Measurements.empty())
+        {
+          return;
+        }
+
+        /** get index timestamp */
+        const double TimestampFirst = States._List.front().Timestamp;
+        const double DeltaTime = States._List.back().Timestamp - TimestampFirst;
+
+        /** resolve all states only once */
+        std::vector<double*> StatePointers;
+        std::vector<DataType> StateTypes;
+        StatePointers.reserve(States._List.size());
+        StateTypes.reserve(States._List.size());
+        for (const StateID &State : States._List)
+        {
+          Data &StateData = _StateData.getElement(State.ID , State.Timestamp, State.Number);
+          StatePointers.emplace_back(StateData.getMeanPointer());
+          StateTypes.emplace_back(StateData.getType());
+        }
+
+        std::vector<ceres::ResidualBlockId> CeresFactorIDs;
+        std::vector<ErrorType*> ErrorModels;
+        CeresFactorIDs.reserve(Measurements.size());
+        ErrorModels.reserve(Measurements.size());
+
+        for (size_t n = 0; n < Measurements.size(); ++n)
+        {
+          /** create factor object */
+          FactorClassType* Factor;
+          if constexpr (FactorClassType::HasDeltaTime == true)
+          {
+            Factor = new FactorClassType(GetNoiseModel(n).get(), Measurements[n], DeltaTime);
+          }
+          else
+          {
+            Factor = new FactorClassType(GetNoiseModel(n).get(), Measurements[n]);
+          }
+
+          /** use the factor to predict */
+          Factor->predict(StatePointers);
+
+          if constexpr (IsSharedErrorModel<ErrorType>::value)
+          {
+            this->registerSharedModel(Factor->getErrorModel()->getState());
+          }
+
+          /** wrap it in ceres cost function */
+          auto CostFunction = makeAutoDiffCostFunction<ErrorType::OutputDim, FactorClassType> (Factor,
+                                                                                             typename FactorClassType::StateDims{},
+                                                                                             typename ErrorType::StateDims{});
+
+          /** add it to the estimation problem  */
+          CeresFactorIDs.emplace_back(_Graph.AddResidualBlock(CostFunction, RobustLoss, StatePointers));
+          ErrorModels.emplace_back(Factor->getErrorModel());
+        }
+
+        /** store the graphs structure */
+        _Structure.addFactors<ErrorType>(CurrentFactorType,
+                                         TimestampFirst,
+                                         CeresFactorIDs,
+                                         ErrorModels,
+                                         States._List,
+                                         StatePointers,
+                                         StateTypes);
+      }
+
+      /** local parametrizations are stateless, so one object per type is shared by all states */
+      ceres::LocalParameterization* getLocalParameterization(DataType Type);
+      ceres::LocalParameterization* getSubsetParameterization(int Size, const std::vector<int> &ConstantIndex);
+
       /** default settings for new ceres::Problems, especially enable_fast_removal = true */
       const ceres::Problem::Options _DefaultProblemOptions = {ceres::Ownership::TAKE_OWNERSHIP, // cost_function_ownership
                                                               ceres::Ownership::TAKE_OWNERSHIP, // loss_function_ownership
-                                                              ceres::Ownership::TAKE_OWNERSHIP, // local_parameterization_ownership
+                                                              ceres::Ownership::DO_NOT_TAKE_OWNERSHIP, // local_parameterization_ownership, see below
                                                               true, // enable_fast_removal
                                                               false, // disable_all_safety_checks
                                                               nullptr, // context
                                                               nullptr // evaluation_callback
                                                               };
 
+      /** owned by the graph instead of ceres, because they are shared and have to outlive the problem */
+      std::map<DataType, std::unique_ptr<ceres::LocalParameterization>> _LocalParameterizations;
+      std::map<std::pair<int, std::vector<int>>, std::unique_ptr<ceres::LocalParameterization>> _SubsetParameterizations;
+
       ceres::Problem _Graph;
       ceres::Solver::Summary _Report;
       ceres::Solver::Options _SolverOptions;
@@ -403,10 +577,78 @@ namespace libRSF
       StateDataSet _StateData;                      /**< holds all state variables */
       FactorGraphStructure _Structure;              /**< represents the structure of variables and factors */
 
+      /** time ordered names of all states, used to find expired states without searching */
+      std::map<Tick, std::vector<string>> _StateQueue;
+
+      /** remove a state from the queue, after its last element at this timestamp was removed */
+      void forgetState(const string &Name, const double Timestamp);
+
+      /** solve with the incremental smoother, all states are constant before and after */
+      bool solveSmoother();
+
+      /** hold all variable states constant or release the held ones */
+      void setAllStatesConstant(const bool Constant);
+
+      /** helper for the recursive covariance */
+      void evaluateJacobian(const std::vector<ceres::ResidualBlockId> &Factors, const std::vector<double*> &States, Matrix &Jacobian);
+
+      /** returns false, if the solve can be skipped */
+      bool prepareIncrementalSolve();
+
+      /** constant states that are owned by the incremental modes, states that were set constant by the user are never released */
+      void holdConstant(double* const StatePointer);
+      void releaseConstant(double* const StatePointer);
+      void releaseAllConstant();
+      void removeParameterBlock(double* const StatePointer);
+
+      /** shared error models of the factors, their latest models are pinned before each solve */
+      void registerSharedModel(const std::shared_ptr<SharedModelState> &State);
+      void pinSharedModels();
+      std::vector<std::weak_ptr<SharedModelState>> _SharedModels;
+
+      /** apply staged modifications and publish the estimates after an asynchronous solve */
+      void applyStaged();
+      void publishSnapshot();
+
+      /** asynchronous solving */
+      std::shared_future<bool> _SolverFuture;
+      std::vector<std::function<void(FactorGraph&)>> _Staged;
+      std::mutex _StagedMutex;
+      std::shared_ptr<const StateDataSet> _Snapshot;
+      mutable std::mutex _SnapshotMutex;
+
+      /** scratch memory for error evaluation, avoids reallocation between calls */
+      std::vector<double> _ErrorBuffer;
+
       /** store information about the past computational load */
       double _SolverDuration;
       int _SolverIterations;
       double _MarginalizationDuration;
+      double _WindowDuration;
+
+      /** select dense or sparse marginalization */
+      MarginalizationType _MarginalizationType;
+
+      /** incremental solving */
+      bool _IncrementalMode;
+      double _ActiveWindow;
+      bool _SkipUnchanged;
+      bool _Modified;                               /**< error models or constant states were changed since the last solve */
+      Tick _ConstantBoundary;                       /**< all states up to this time are constant */
+      std::unordered_set<double*> _HeldConstant;
+
+      /** incremental smoother */
+      bool _SmootherMode;
+      bool _SmootherRelinearizeAll;
+      double _RelinearizationThreshold;
+      int _MaxPropagationSteps;
+      std::vector<double*> _NewStates;
+
+      /** square root information of the last newest states for recursive covariances and the structure revision it belongs to */
+      std::vector<StateID> _CovarianceStates;
+      std::vector<int> _CovarianceSizes;
+      Matrix _CovarianceSqrtInfo;
+      int64_t _CovarianceRevision = 0;
   };
 }
 
@@ -33,9 +33,13 @@
 #define ROBUSTOPTIMIZATION_H
 
 #include "StateDataSet.h"
+#include "LocalCostEvaluator.h"
 
 #include <ceres/ceres.h>
+
+#include <cmath>
 #include <thread>
+#include <vector>
 
 namespace libRSF
 {
@@ -46,6 +50,11 @@ namespace libRSF
                                  std::vector<double> &Costs);
 
 
+  /** @brief Samples the cost surface of one state on a regular grid in parallel.
+   *
+   * The grid is split across threads and each worker evaluates its points with its own copy of a LocalCostEvaluator.
+   * The problem itself is not modified.
+   */
   template<int Dim>
   void EvaluateCostSurface(ceres::Problem &Graph,
                            double * const StatePointer,
@@ -55,106 +64,98 @@ namespace libRSF
   {
     typedef VectorStatic<Dim> SizedVector;
 
-    /** configure evaluation */
-    ceres::Problem::EvaluateOptions Options;
-    Options.apply_loss_function = true;
-    Options.num_threads = std::thread::hardware_concurrency();
-    Options.parameter_blocks = {StatePointer};
-
-    /** save original value */
-    VectorRef<double, Dim> State(StatePointer);
-    const SizedVector OriginalState = State;
+    /** original value */
+    const SizedVector OriginalState = VectorRef<double, Dim>(StatePointer);
 
     /** create 1D point set */
-    Vector Lin = Vector::LinSpaced(Points, -Range/2, Range/2);
+    const Vector Lin = Vector::LinSpaced(Points, -Range/2, Range/2);
 
-    /** create nD point set */
-    std::vector<Vector> Grid;
-    for (int nDim = 0; nDim < Dim; ++nDim)
-    {
-      Grid.push_back((Lin.array() + State(nDim)).matrix());
-    }
+    /** cache the factors of the state */
+    const LocalCostEvaluator<Dim> Evaluator(Graph, StatePointer);
 
-    /** create multi dimensional index */
-    std::vector<int> Index;
-    for (int nDim = 0; nDim < Dim; ++nDim)
-    {
-      Index.push_back(0);
-    }
+    /** preallocated grid with the results */
+    const int64_t PointNumber = static_cast<int64_t>(std::pow(Points, Dim));
+    std::vector<double> Costs(PointNumber);
+    std::vector<SizedVector> Gradients(PointNumber);
+    std::vector<MatrixStatic<Dim, Dim>> Hessians(PointNumber);
 
-    /** loop over grid */
-    for (uint64_t n = 0; n < std::pow(Points,Dim); ++n)
+    /** position of one grid point, the first dimension is the fastest one */
+    auto GetPoint = [&](int64_t n)
     {
-      /** write point */
+      SizedVector Point;
       for (int nDim = 0; nDim < Dim; ++nDim)
       {
-        State.segment(nDim,1) = Grid.at(nDim).segment(Index.at(nDim),1);
+        Point(nDim) = OriginalState(nDim) + Lin(n % Points);
+        n /= Points;
       }
+      return Point;
+    };
 
-      /** evaluate */
-      double Cost;
-      std::vector<double> Gradient;
-      ceres::CRSMatrix JacobianCRS;
-      Graph.Evaluate(Options, &Cost, nullptr, &Gradient, &JacobianCRS);
-
-      /** calculate the Hessian */
-      Matrix Jacobian;
-      CRSToMatrix(JacobianCRS, Jacobian);
-      MatrixStatic<Dim,Dim> Hessian = Jacobian.transpose()*Jacobian;
+    /** evaluate a contiguous part of the grid */
+    auto Worker = [&](const int64_t Start, const int64_t End)
+    {
+      LocalCostEvaluator<Dim> LocalEvaluator(Evaluator);
 
-      /** create state data to store the result */
-      Data CostState;
-      if (Dim == 1)
+      for (int64_t n = Start; n < End; ++n)
       {
-        CostState = Data(DataType::CostGradient1, 0.0);
-      }
-      else if (Dim == 2)
-      {
-        CostState = Data(DataType::CostGradient2, 0.0);
-      }
-      else if (Dim == 3)
-      {
-        CostState = Data(DataType::CostGradient3, 0.0);
-      }
-      else
-      {
-        PRINT_ERROR("There is no data type for ", Dim, " dimensional data!");
+        LocalEvaluator.evaluate(GetPoint(n), Costs.at(n), &Gradients.at(n), &Hessians.at(n));
       }
+    };
+
+    /** split the grid across threads */
+    const int64_t ThreadNumber = std::max<int64_t>(1, std::min<int64_t>(std::thread::hardware_concurrency(), PointNumber));
+    const int64_t ChunkSize = (PointNumber + ThreadNumber - 1) / ThreadNumber;
+    std::vector<std::thread> Threads;
+    for (int64_t t = 1; t < ThreadNumber; ++t)
+    {
+      Threads.emplace_back(Worker, std::min(t * ChunkSize, PointNumber), std::min((t + 1) * ChunkSize, PointNumber));
+    }
+    Worker(0, std::min(ChunkSize, PointNumber));
+    for (std::thread &Thread : Threads)
+    {
+      Thread.join();
+    }
+
+    /** convert to data at the end */
+    DataType CostType;
+    if (Dim == 1)
+    {
+      CostType = DataType::CostGradient1;
+    }
+    else if (Dim == 2)
+    {
+      CostType = DataType::CostGradient2;
+    }
+    else if (Dim == 3)
+    {
+      CostType = DataType::CostGradient3;
+    }
+    else
+    {
+      PRINT_ERROR("There is no data type for ", Dim, " dimensional data!");
+      return;
+    }
+
+    for (int64_t n = 0; n < PointNumber; ++n)
+    {
+      Data CostState(CostType, 0.0);
 
       /** point where the cost is evaluated */
-      CostState.setMean(State);
+      CostState.setMean(GetPoint(n));
 
       /** actual cost value */
-      CostState.setValueScalar(DataElement::Cost, Cost);
+      CostState.setValueScalar(DataElement::Cost, Costs.at(n));
 
       /** gradient of the cost surface */
-      SizedVector GradientVector(Gradient.data());
-      CostState.setValue(DataElement::Gradient, GradientVector);
+      CostState.setValue(DataElement::Gradient, Gradients.at(n));
 
       /** hessian at the evaluated point */
-      VectorStatic<Dim*Dim> HessianVector(Hessian.data());
+      VectorStatic<Dim*Dim> HessianVector(Hessians.at(n).data());
       CostState.setValue(DataElement::Hessian, HessianVector);
 
       /** push to data set */
       Result.addElement(CostState);
-
-      /**increment indexes */
-      Index.at(0)++;
-      for (int i = 0; i < Dim; ++i)
-      {
-        /** if one index is maxed */
-        if (Index.at(i) >= Points && i < (Dim-1))
-        {
-          /** reset current index */
-          Index.at(i) = 0;
-          /** increment next index level */
-          Index.at(i+1)++;
-        }
-      }
     }
-
-    /** restore original value */
-    State = OriginalState;
   }
 }
 
@@ -39,6 +39,10 @@
 #include "SensorDataSet.h"
 #include "error_models/ErrorModel.h"
 
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
 namespace libRSF
 {
 
@@ -53,7 +57,7 @@ namespace libRSF
       struct StateInfo
       {
         std::string Name;
-        double Timestamp;
+        Tick Timestamp;
         int Number;
         DataType Type;
       };
@@ -61,13 +65,30 @@ namespace libRSF
       struct FactorInfo
       {
         FactorType Type;
-        double Timestamp;
+        Tick Timestamp;
         int Number;
         int ErrorInputSize;
         int ErrorOutputSize;
         ErrorModelBase* ErrorModel = nullptr;
       };
 
+      /** modifications since the last reset */
+      struct Changes
+      {
+        int AddedStates = 0;
+        int RemovedStates = 0;
+        int AddedFactors = 0;
+        int RemovedFactors = 0;
+
+        /** states that are connected to added factors, may contain duplicates */
+        std::vector<double*> ConnectedStates;
+
+        bool empty() const
+        {
+          return AddedStates == 0 && RemovedStates == 0 && AddedFactors == 0 && RemovedFactors == 0;
+        }
+      };
+
       /** collect all informations that are required to remove the BaseState from the graph */
       void getMarginalizationInfo(const std::vector<double*> &BaseStates,
                                   std::vector<double*> &ConnectedStates,
@@ -87,52 +108,82 @@ namespace libRSF
                      const std::vector<double*> &StatePointers,
                      const std::vector<DataType> &StateTypes)
       {
-        /** add to time dependent representation */
-        _FactorList.addElement(Type, Timestamp, CeresID);
-
-        /** create ID and add to unordered maps */
-        const FactorID Factor(Type, Timestamp, _FactorList.countElement(Type, Timestamp)-1);
+        /** add to time dependent representation, the number is a stable handle */
+        const int Number = this->insertFactor(Type, Timestamp, CeresID);
 
         /** collect factor information */
         FactorInfo Info;
         Info.Type = Type;
-        Info.Timestamp = Timestamp;
-        Info.Number = Factor.Number;
+        Info.Timestamp = Tick(Timestamp);
+        Info.Number = Number;
         Info.ErrorInputSize = ErrorModel->InputDim;
         Info.ErrorOutputSize = ErrorModel->OutputDim;
         Info.ErrorModel = static_cast<ErrorModelBase*>(ErrorModel);
         _Factors.emplace(CeresID, Info);
 
         /** collect state information */
-        for(int n = 0; n < static_cast<int>(States.size()); n++)
+        this->addStates(States, StatePointers, StateTypes);
+      }
+
+      /** add multiple factors of one type that share the same states at once */
+      template <typename ErrorType>
+      void addFactors(const FactorType Type,
+                      const double Timestamp,
+                      const std::vector<ceres::ResidualBlockId> &CeresIDs,
+                      const std::vector<ErrorType*> &ErrorModels,
+                      const std::vector<StateID> &States,
+                      const std::vector<double*> &StatePointers,
+                      const std::vector<DataType> &StateTypes)
+      {
+        _Factors.reserve(_Factors.size() + CeresIDs.size());
+
+        /** collect factor information */
+        FactorInfo Info;
+        Info.Type = Type;
+        Info.Timestamp = Tick(Timestamp);
+        Info.ErrorInputSize = ErrorType::InputDim;
+        Info.ErrorOutputSize = ErrorType::OutputDim;
+        for (size_t n = 0; n < CeresIDs.size(); ++n)
         {
-          if(_States.count(StatePointers.at(n)) == 0) /**< check if already existing */
-          {
-            StateInfo State;
-            State.Name = States.at(n).ID;
-            State.Timestamp = States.at(n).Timestamp;
-            State.Number = States.at(n).Number;
-            State.Type = StateTypes.at(n);
-
-            _States.emplace(StatePointers.at(n), State);
-          }
+          Info.Number = this->insertFactor(Type, Timestamp, CeresIDs.at(n));
+          Info.ErrorModel = static_cast<ErrorModelBase*>(ErrorModels.at(n));
+          _Factors.emplace(CeresIDs.at(n), Info);
         }
+
+        /** collect state information */
+        this->addStates(States, StatePointers, StateTypes);
       }
 
       void removeFactor(const FactorID &Factor);
       void removeFactor(const ceres::ResidualBlockId Factor);
       void removeState(const StateID &State);
+      void removeState(double* const StatePointer);
+
+      /** remove all factors of one type up to a timestamp at once, the removed IDs are returned to remove them from ceres */
+      void removeFactorsBeforeOrEqual(const FactorType Type, const double Timestamp, std::vector<ceres::ResidualBlockId> &Removed);
+
+      /** same for all factor types, only the expired part of the eviction queue is visited */
+      void removeAllFactorsBeforeOrEqual(const double Timestamp, std::vector<ceres::ResidualBlockId> &Removed);
 
-      /** query single variables */
-      void getResidualID(const FactorID &Factor, ceres::ResidualBlockId &Residual) const;
-      void getErrorModel(const FactorID &Factor, ErrorModelBase* &ErroModel) const;
-      void getErrorInputSize(const FactorID &Factor, int &ResidualSize) const;
-      void getErrorOutputSize(const FactorID &Factor, int &ResidualSize) const;
+      /** query single variables, return false if the factor does not exist (anymore) */
+      bool getResidualID(const FactorID &Factor, ceres::ResidualBlockId &Residual) const;
+      bool getErrorModel(const FactorID &Factor, ErrorModelBase* &ErroModel) const;
+      bool getErrorInputSize(const FactorID &Factor, int &ResidualSize) const;
+      bool getErrorOutputSize(const FactorID &Factor, int &ResidualSize) const;
+      bool getFactorInfo(const ceres::ResidualBlockId Factor, FactorInfo &Info) const;
 
       /** query multiple variables */
       void getFactorIDs(const FactorType Type, std::vector<FactorID> &Factors) const;
       void getErrorModels(const FactorType Type, std::vector<ErrorModelBase*> &Models) const;
       void getResidualIDs(const FactorType Type, std::vector<ceres::ResidualBlockId> &Blocks) const;
+      void getResidualIDs(const FactorType Type, const double Timestamp, std::vector<ceres::ResidualBlockId> &Blocks) const;
+
+      /** track modifications of the structure */
+      const Changes& getChanges() const;
+      void resetChanges();
+
+      /** counts all modifications, is not reset */
+      int64_t getRevision() const;
 
       /** query connected things */
       void getFactorsOfState(const StateID &State, std::vector<FactorID> &Factors) const;
@@ -155,13 +206,48 @@ namespace libRSF
       bool checkFactor(const FactorType Type) const;
 
     private:
+      /** all factors of one type at one timestamp
+       *  the number of a factor is its index, removed factors leave a nullptr, so the other numbers stay valid */
+      struct FactorSlot
+      {
+        std::vector<ceres::ResidualBlockId> Factors;
+        int Count = 0;
+      };
+
+      /** time ordered slots of one factor type */
+      struct FactorTimeline
+      {
+        std::map<Tick, FactorSlot> Slots;
+        int Count = 0;
+      };
+
+      /** add states that are not known yet */
+      void addStates(const std::vector<StateID> &States,
+                     const std::vector<double*> &StatePointers,
+                     const std::vector<DataType> &StateTypes);
+
+      /** add to the time dependent representation and return the number of the new factor */
+      int insertFactor(const FactorType Type, const double Timestamp, const ceres::ResidualBlockId CeresID);
+
+      /** remove a slot that was erased from the eviction queue */
+      void forgetSlot(const FactorType Type, const Tick Timestamp);
+
+      /** returns nullptr if there is no factor */
+      const FactorSlot* findSlot(const FactorType Type, const double Timestamp) const;
 
       /** mapping ceres --> libRSF */
-      std::map<double*, StateInfo> _States;
-      std::map<ceres::ResidualBlockId, FactorInfo> _Factors;
+      std::unordered_map<double*, StateInfo> _States;
+      std::unordered_map<ceres::ResidualBlockId, FactorInfo> _Factors;
 
       /** mapping libRSF --> ceres */
-      FactorIDSet _FactorList;
+      std::map<FactorType, FactorTimeline> _FactorList;
+
+      /** time ordered queue of all slots, every removal of a slot removes its entry */
+      std::map<Tick, std::vector<FactorType>> _EvictionQueue;
+
+      /** counts modifications since the last reset */
+      Changes _Changes;
+      int64_t _Revision = 0;
       StateDataSet * const _Data;
 
       /** mapping states <--> factors */
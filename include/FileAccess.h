@@ -46,6 +46,7 @@
 #include <iomanip>
 #include <fstream>
 #include <memory>
+#include <functional>
 
 using std::vector;
 using std::string;
@@ -56,10 +57,59 @@ namespace libRSF
   void ReadDataFromFile(const string Filename,
                         SensorDataSet& Data);
 
+  /** pass each measurement to a handle instead of storing all of them, the handle returns false to stop reading */
+  void ReadDataFromFile(const string Filename,
+                        const std::function<bool(const Data&)> &Handle);
+
+  /** like above, but the measurements of all types are passed in time order, without loading the whole file */
+  void ReadDataFromFileInTimeOrder(const string Filename,
+                                   const std::function<bool(const Data&)> &Handle);
+
+  /** parse line-aligned chunks of one or more files on a pool of threads (0 = all cores),
+   *  chunks are at least MinChunkSize bytes to keep the merge cheap */
+  void ReadDataFromFileParallel(const string Filename,
+                                SensorDataSet& Data,
+                                const int ThreadNumber = 0,
+                                const size_t MinChunkSize = 1 << 20);
+
+  void ReadDataFromFilesParallel(const std::vector<string> &Filenames,
+                                 std::vector<SensorDataSet>& Data,
+                                 const int ThreadNumber = 0,
+                                 const size_t MinChunkSize = 1 << 20);
+
   void WriteDataToFile(const string Filename,
                        const string DataName,
                        const StateDataSet& Data,
                        const bool Append = false);
+
+  /** write several states in one pass, one after another */
+  void WriteMultipleDataToFile(const string Filename,
+                               const std::vector<string> &DataNames,
+                               const StateDataSet& Data,
+                               const bool Append = false);
+
+  /** binary format, that stores the measurements column-wise and grouped by their type
+   *
+   * Layout (native byte order, every field is aligned to 8 byte):
+   *  header: char[4] "RSFB" | uint32 version | uint64 number of types
+   *  per type: uint64 name length | name padded to 8 byte | uint64 values per measurement | uint64 number of measurements
+   *            | one column of doubles per value
+   */
+  bool WriteDataToBinaryFile(const string Filename,
+                             const SensorDataSet& Data);
+
+  /** write states in the same binary format, so they can be read as measurements */
+  bool WriteDataToBinaryFile(const string Filename,
+                             const std::vector<string> &DataNames,
+                             const StateDataSet& Data);
+
+  /** read a binary file via memory mapping */
+  bool ReadDataFromBinaryFile(const string Filename,
+                              SensorDataSet& Data);
+
+  /** convert an ASCII input file to the binary format */
+  bool ConvertDataFileToBinary(const string InputFilename,
+                               const string OutputFilename);
 }
 
 #endif // FILEACCESS_H
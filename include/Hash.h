@@ -60,7 +60,7 @@ namespace std
     size_t operator()(const libRSF::FactorID& Object) const
     {
       return CombineHash(hash<libRSF::FactorType>()(Object.ID),
-                         hash<double>()(Object.Timestamp),
+                         hash<libRSF::Tick>()(Object.Timestamp),
                          hash<size_t>()(Object.Number));
     }
   };
@@ -71,7 +71,7 @@ namespace std
     size_t operator()(const libRSF::StateID& Object) const
     {
       return CombineHash(hash<string>()(Object.ID),
-                         hash<double>()(Object.Timestamp),
+                         hash<libRSF::Tick>()(Object.Timestamp),
                          hash<size_t>()(Object.Number));
     }
   };
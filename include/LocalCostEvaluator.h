@@ -0,0 +1,254 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file LocalCostEvaluator.h
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Evaluates the part of the cost function that depends on a single state.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef LOCALCOSTEVALUATOR_H
+#define LOCALCOSTEVALUATOR_H
+
+#include "VectorTypes.h"
+#include "Messages.h"
+
+#include <ceres/ceres.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace libRSF
+{
+  /** @brief Evaluates cost, gradient and Gauss-Newton Hessian of the whole problem as a function of one state.
+   *
+   * The residual blocks of the state are cached once, so each evaluation scales with the number of factors connected
+   * to the state instead of the size of the problem. The cost of all other factors is a constant offset.
+   * The evaluation works on an internal copy of the state and never modifies the problem.
+   * It is not thread-safe, but copies are cheap, so each thread should use its own copy.
+   * Dim is the global size of the state. States with a smaller local size (e.g. UnitCircle) are rejected and every
+   * evaluation fails, because their derivatives can not be mapped into a space of size Dim.
+   */
+  template<int Dim>
+  class LocalCostEvaluator
+  {
+    public:
+      LocalCostEvaluator(ceres::Problem &Graph, double* const StatePointer)
+      {
+        /** split factors into the connected ones and the constant rest */
+        std::vector<ceres::ResidualBlockId> Connected;
+        Graph.GetResidualBlocksForParameterBlock(StatePointer, &Connected);
+
+        std::vector<ceres::ResidualBlockId> Others;
+        Graph.GetResidualBlocks(&Others);
+        std::sort(Connected.begin(), Connected.end());
+        Others.erase(std::remove_if(Others.begin(), Others.end(), [&Connected](const ceres::ResidualBlockId ID)
+        {
+          return std::binary_search(Connected.begin(), Connected.end(), ID);
+        }), Others.end());
+
+        _CostOffset = 0.0;
+        if (Others.empty() == false)
+        {
+          ceres::Problem::EvaluateOptions Options;
+          Options.apply_loss_function = true;
+          Options.num_threads = std::thread::hardware_concurrency();
+          Options.residual_blocks = Others;
+          Graph.Evaluate(Options, &_CostOffset, nullptr, nullptr, nullptr);
+        }
+
+        /** cache the connected factors */
+        int MaxResiduals = 0;
+        for (const ceres::ResidualBlockId ID : Connected)
+        {
+          Block Factor;
+          Factor.Cost = Graph.GetCostFunctionForResidualBlock(ID);
+          Factor.Loss = Graph.GetLossFunctionForResidualBlock(ID);
+
+          std::vector<double*> Parameters;
+          Graph.GetParameterBlocksForResidualBlock(ID, &Parameters);
+          Factor.Parameters.assign(Parameters.begin(), Parameters.end());
+          Factor.StateIndex = static_cast<int>(std::find(Parameters.begin(), Parameters.end(), StatePointer) - Parameters.begin());
+
+          MaxResiduals = std::max(MaxResiduals, Factor.Cost->num_residuals());
+          _Blocks.push_back(Factor);
+        }
+
+        /** map the derivatives into the local space of the state */
+        _Lift.setIdentity();
+        _Valid = true;
+        const ceres::LocalParameterization* Parameterization = Graph.GetParameterization(StatePointer);
+        if (Parameterization != nullptr)
+        {
+          if (Parameterization->LocalSize() == Dim)
+          {
+            Parameterization->ComputeJacobian(StatePointer, _Lift.data());
+          }
+          else
+          {
+            PRINT_ERROR("Local size ", Parameterization->LocalSize(), " of the state differs from its size ", Dim, "!");
+            _Valid = false;
+          }
+        }
+
+        /** allocate buffers once */
+        _Residual.resize(MaxResiduals);
+        _Jacobian.resize(MaxResiduals, Dim);
+      }
+      ~LocalCostEvaluator() = default;
+
+      /** evaluate the cost at a given point, gradient and hessian are optional */
+      bool evaluate(const VectorStatic<Dim> &Point,
+                    double &Cost,
+                    VectorStatic<Dim>* Gradient = nullptr,
+                    MatrixStatic<Dim, Dim>* Hessian = nullptr)
+      {
+        if (_Valid == false)
+        {
+          Cost = std::numeric_limits<double>::quiet_NaN();
+          return false;
+        }
+
+        _State = Point;
+
+        const bool Derivatives = (Gradient != nullptr || Hessian != nullptr);
+        if (Gradient != nullptr)
+        {
+          Gradient->setZero();
+        }
+        if (Hessian != nullptr)
+        {
+          Hessian->setZero();
+        }
+
+        Cost = _CostOffset;
+        bool Success = true;
+        for (Block &Factor : _Blocks)
+        {
+          const int Rows = Factor.Cost->num_residuals();
+          auto Residual = _Residual.head(Rows);
+
+          /** the jacobian buffer is row-major, so the first rows are contiguous */
+          auto Jacobian = _Jacobian.topRows(Rows);
+
+          /** only the jacobian of our state is required */
+          _Jacobians.assign(Factor.Parameters.size(), nullptr);
+          if (Derivatives)
+          {
+            _Jacobians.at(Factor.StateIndex) = _Jacobian.data();
+          }
+
+          Factor.Parameters.at(Factor.StateIndex) = _State.data();
+          if (Factor.Cost->Evaluate(Factor.Parameters.data(), _Residual.data(), Derivatives ? _Jacobians.data() : nullptr) == false)
+          {
+            Success = false;
+            continue;
+          }
+
+          const double SquaredNorm = Residual.squaredNorm();
+          double Rho[3] = {SquaredNorm, 1.0, 0.0};
+          if (Factor.Loss != nullptr)
+          {
+            Factor.Loss->Evaluate(SquaredNorm, Rho);
+          }
+          Cost += 0.5 * Rho[0];
+
+          if (Derivatives)
+          {
+            /** derivatives w.r.t. the local space of the state */
+            const VectorStatic<Dim> LocalGradient = _Lift.transpose() * (Jacobian.transpose() * Residual);
+
+            if (Gradient != nullptr)
+            {
+              *Gradient += Rho[1] * LocalGradient;
+            }
+
+            if (Hessian != nullptr)
+            {
+              const MatrixStatic<Dim, Dim> JTJ = _Lift.transpose() * (Jacobian.transpose() * Jacobian) * _Lift;
+
+              /** apply the loss function like ceres does (Triggs correction) in the normal equations */
+              if (Factor.Loss == nullptr || SquaredNorm == 0.0 || Rho[2] <= 0.0)
+              {
+                *Hessian += Rho[1] * JTJ;
+              }
+              else
+              {
+                const double Alpha = 1.0 - std::sqrt(1.0 + 2.0 * SquaredNorm * Rho[2] / Rho[1]);
+                const double Scale = Alpha / SquaredNorm;
+                *Hessian += Rho[1] * (JTJ + (Scale * Scale * SquaredNorm - 2.0 * Scale) * LocalGradient * LocalGradient.transpose());
+              }
+            }
+          }
+        }
+
+        if (Success == false)
+        {
+          Cost = std::numeric_limits<double>::quiet_NaN();
+        }
+
+        return Success;
+      }
+
+      /** cost of all factors that are not connected to the state */
+      double getCostOffset() const
+      {
+        return _CostOffset;
+      }
+
+      /** number of factors that are connected to the state */
+      int getFactorNumber() const
+      {
+        return static_cast<int>(_Blocks.size());
+      }
+
+    private:
+      /** cached information of one connected factor */
+      struct Block
+      {
+        const ceres::CostFunction* Cost;
+        const ceres::LossFunction* Loss;
+        std::vector<const double*> Parameters;
+        int StateIndex;
+      };
+
+      std::vector<Block> _Blocks;
+      double _CostOffset;
+      MatrixStatic<Dim, Dim> _Lift;
+      bool _Valid;
+
+      /** local copy of the state and evaluation buffers */
+      VectorStatic<Dim> _State;
+      Vector _Residual;
+      MatrixT<double, Dynamic, Dim> _Jacobian;
+      std::vector<double*> _Jacobians;
+  };
+}
+
+#endif // LOCALCOSTEVALUATOR_H
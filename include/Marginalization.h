@@ -36,10 +36,19 @@
 
 namespace libRSF
 {
+  /** select the algebra that is used to compute the Schur complement */
+  enum class MarginalizationType {Dense, Sparse};
+
+  /** dense reference implementation */
   void Marginalize(const Vector &Residual, const Matrix &Jacobian,
                    Vector &ResidualMarg, Matrix &JacobianMarg,
                    const int MarginalSize, const double HessianInflation = 1.0);
 
+  /** sparse implementation that exploits the block structure of the marginalized states */
+  void MarginalizeSparse(const Vector &Residual, const ceres::CRSMatrix &Jacobian,
+                         Vector &ResidualMarg, Matrix &JacobianMarg,
+                         const std::vector<int> &MarginalBlockSizes, const double HessianInflation = 1.0);
+
 }
 
 #endif // MARGINALIZATION_H
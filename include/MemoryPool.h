@@ -0,0 +1,109 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file MemoryPool.h
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Pool allocation for small objects that are created and destroyed frequently.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef MEMORYPOOL_H
+#define MEMORYPOOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace libRSF
+{
+  /** thread-safe allocator for blocks of one fixed size
+   *
+   * Freed blocks are kept in a free list and reused, memory is only returned to the system when the pool is destroyed. */
+  class MemoryPool
+  {
+    public:
+      explicit MemoryPool(size_t BlockSize, size_t BlocksPerChunk = 256);
+      ~MemoryPool();
+
+      MemoryPool(const MemoryPool&) = delete;
+      MemoryPool& operator = (const MemoryPool&) = delete;
+
+      void* allocate();
+      void deallocate(void* Pointer);
+
+      size_t getBlockSize() const;
+
+      /** returns the shared pool for objects of this size or nullptr if it is too large to be pooled */
+      static MemoryPool* Get(size_t Size);
+
+      /** objects up to this size are pooled */
+      static constexpr size_t MaxObjectSize = 1024;
+      static constexpr size_t Granularity = alignof(std::max_align_t);
+
+    private:
+      struct FreeBlock
+      {
+        FreeBlock* Next;
+      };
+
+      void addChunk();
+
+      size_t _BlockSize;
+      size_t _BlocksPerChunk;
+      FreeBlock* _FreeList;
+      std::vector<void*> _Chunks;
+      std::mutex _Mutex;
+  };
+
+  /** derive from this class to allocate objects from the memory pools
+   *
+   * The class specific operators are inherited, so all derived types are pooled according to their own size.
+   * Deleting through a base pointer requires a virtual destructor, as usual. */
+  class PoolAllocated
+  {
+    public:
+      static void* operator new (size_t Size);
+      static void operator delete (void* Pointer, size_t Size);
+
+      /** over-aligned types are not pooled */
+      static void* operator new (size_t Size, std::align_val_t Alignment);
+      static void operator delete (void* Pointer, size_t Size, std::align_val_t Alignment);
+  };
+
+  /** adds pool allocation to an existing class, e.g. to ceres cost functions */
+  template <typename BaseType>
+  class Pooled : public BaseType, public PoolAllocated
+  {
+    public:
+      using BaseType::BaseType;
+
+      using PoolAllocated::operator new;
+      using PoolAllocated::operator delete;
+  };
+}
+
+#endif // MEMORYPOOL_H
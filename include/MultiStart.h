@@ -0,0 +1,76 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file MultiStart.h
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Solves the same problem from many initial values in parallel.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef MULTISTART_H
+#define MULTISTART_H
+
+#include "FactorGraph.h"
+#include "StateDataSet.h"
+#include "VectorTypes.h"
+
+#include <ceres/ceres.h>
+
+#include <functional>
+
+namespace libRSF
+{
+  /** has to add all states and factors to an empty graph */
+  typedef std::function<bool(FactorGraph&)> GraphBuilder;
+
+  /** @brief Solves one problem from many initial values of a single state.
+   *
+   * Each worker thread creates its own graph with the builder and solves a part of the initial values with it.
+   * The results are stored in the order of the initial values, independent of the number of threads.
+   *
+   * @param Builder Creates the problem in an empty graph.
+   * @param Options Solver options of each run, the threads are used for the runs instead of a single solve.
+   * @param State The state that is initialized.
+   * @param InitialValues Values of the state at the beginning of each run.
+   * @param PreOptimizationData Receives the state before each run.
+   * @param PostOptimizationData Receives the state after each run.
+   * @param SolverData Receives duration and iterations of each run as IterationSummary with the name SummaryName.
+   * @param SummaryName Name of the IterationSummary elements.
+   * @param ThreadNumber Number of worker threads, 0 means all cores.
+   * @return true if all graphs could be created.
+   */
+  bool SolveMultiStart(const GraphBuilder &Builder,
+                       const ceres::Solver::Options &Options,
+                       const StateID &State,
+                       const VectorVectorSTL<Dynamic> &InitialValues,
+                       StateDataSet &PreOptimizationData,
+                       StateDataSet &PostOptimizationData,
+                       StateDataSet &SolverData,
+                       const string &SummaryName,
+                       int ThreadNumber = 0);
+}
+
+#endif // MULTISTART_H
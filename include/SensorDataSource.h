@@ -0,0 +1,186 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file SensorDataSource.h
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Streaming interface to feed measurements continuously into an estimator.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef SENSORDATASOURCE_H
+#define SENSORDATASOURCE_H
+
+#include "SensorDataSet.h"
+#include "FileAccess.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <map>
+
+namespace libRSF
+{
+  /** bounded single-producer single-consumer ring buffer without locks */
+  template <typename ObjectType>
+  class LockFreeQueue
+  {
+    public:
+      explicit LockFreeQueue(const size_t Capacity) : _Buffer(Capacity + 1), _Head(0), _Tail(0)
+      {}
+      ~LockFreeQueue() = default;
+
+      /** called by the producer only */
+      bool push(const ObjectType &Object)
+      {
+        const size_t Tail = _Tail.load(std::memory_order_relaxed);
+        const size_t Next = this->increment(Tail);
+
+        /** queue is full */
+        if (Next == _Head.load(std::memory_order_acquire))
+        {
+          return false;
+        }
+
+        _Buffer[Tail] = Object;
+        _Tail.store(Next, std::memory_order_release);
+        return true;
+      }
+
+      /** called by the consumer only */
+      bool pop(ObjectType &Object)
+      {
+        const size_t Head = _Head.load(std::memory_order_relaxed);
+
+        /** queue is empty */
+        if (Head == _Tail.load(std::memory_order_acquire))
+        {
+          return false;
+        }
+
+        Object = _Buffer[Head];
+        _Head.store(this->increment(Head), std::memory_order_release);
+        return true;
+      }
+
+      bool empty() const
+      {
+        return _Head.load(std::memory_order_acquire) == _Tail.load(std::memory_order_acquire);
+      }
+
+    private:
+      size_t increment(const size_t Index) const
+      {
+        return (Index + 1 == _Buffer.size()) ? 0 : Index + 1;
+      }
+
+      std::vector<ObjectType> _Buffer;
+
+      /** separate cache lines to avoid false sharing between both threads */
+      alignas(64) std::atomic<size_t> _Head;
+      alignas(64) std::atomic<size_t> _Tail;
+  };
+
+  /** measurements are pushed by one thread and pulled as time-ordered batches by another one */
+  class SensorDataSource
+  {
+    public:
+      typedef std::chrono::steady_clock Clock;
+
+      /** ReorderDelay is the time [s] a measurement may arrive later than newer measurements */
+      explicit SensorDataSource(const size_t Capacity = 4096, const double ReorderDelay = 0.0);
+      virtual ~SensorDataSource() = default;
+
+      /** producer interface */
+      bool push(const Data &Measurement);
+      void pushBlocking(const Data &Measurement);
+      void finish();
+
+      /** consumer interface, returns false if no measurement was added to the batch
+       *  without watermark, all complete timestamps are pulled, an explicit watermark is inclusive */
+      bool pullBatch(SensorDataSet &Batch);
+      bool pullBatch(const double Watermark, SensorDataSet &Batch);
+
+      /** true if the producer has finished and all measurements have been pulled */
+      bool isFinished();
+
+      /** all measurements before this timestamp are complete */
+      double getWatermark() const;
+
+      /** time [s] between the arrival of the oldest measurement of the last batch and now, zero before the first batch */
+      double getLatency() const;
+
+      /** number of measurements that arrived after their timestamp was already released */
+      int getDroppedNumber() const;
+
+    private:
+      struct Entry
+      {
+        Data Measurement;
+        Clock::time_point Arrival;
+      };
+
+      /** move everything from the queue into the reorder buffer */
+      void drainQueue();
+
+      /** pass all measurements before End to the batch */
+      bool release(const std::multimap<Tick, Entry>::iterator End, SensorDataSet &Batch);
+
+      LockFreeQueue<Entry> _Queue;
+      std::atomic<bool> _Finished;
+
+      /** consumer side */
+      std::multimap<Tick, Entry> _ReorderBuffer;
+      double _ReorderDelay;
+      double _LatestTimestamp;
+      double _ReleasedUntil;
+      Clock::time_point _OldestArrival = Clock::time_point();
+      int _Dropped;
+  };
+
+  /** replays a file with a defined speed (1.0 = real-time, 0.0 = as fast as possible) in a separate thread */
+  class FileReplaySource
+  {
+    public:
+      FileReplaySource(const std::string &Filename, SensorDataSource &Target, const double Speed = 1.0);
+      virtual ~FileReplaySource();
+
+      void start();
+      void stop();
+
+    private:
+      void run();
+
+      std::string _Filename;
+      SensorDataSource &_Target;
+      double _Speed;
+
+      std::thread _Thread;
+      std::atomic<bool> _Stop;
+  };
+}
+
+#endif // SENSORDATASOURCE_H
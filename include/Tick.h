@@ -0,0 +1,142 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Tick.h
+ * @author libRSF contributors
+ * @date 15.10.2026
+ * @brief Integer representation of timestamps with a fixed resolution.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <cstdint>
+#include <cmath>
+#include <ostream>
+#include <functional>
+
+/** resolution of all timestamps, can be set with the CMake variable LIBRSF_TICKS_PER_SECOND */
+#ifndef LIBRSF_TICKS_PER_SECOND
+#define LIBRSF_TICKS_PER_SECOND 1000
+#endif
+
+namespace libRSF
+{
+  /** timestamp that is stored as integer number of ticks
+   *
+   * Comparisons and hashes are pure integer operations. The conversion to seconds is implicit, so ticks can be used
+   * wherever a double timestamp is expected. The conversion from seconds is explicit, because it includes rounding. */
+  class Tick
+  {
+    public:
+      static constexpr int64_t TicksPerSecond = LIBRSF_TICKS_PER_SECOND;
+      static constexpr double SecondsPerTick = 1.0 / LIBRSF_TICKS_PER_SECOND;
+
+      constexpr Tick() : _Count(0) {}
+
+      explicit Tick(const double Time) : _Count(static_cast<int64_t>(std::llround(Time * TicksPerSecond)))
+      {}
+
+      static constexpr Tick FromCount(const int64_t Count)
+      {
+        Tick Result;
+        Result._Count = Count;
+        return Result;
+      }
+
+      Tick& operator = (const double Time)
+      {
+        *this = Tick(Time);
+        return *this;
+      }
+
+      /** access the internal representation */
+      constexpr int64_t count() const
+      {
+        return _Count;
+      }
+
+      constexpr double toSeconds() const
+      {
+        return static_cast<double>(_Count) * SecondsPerTick;
+      }
+
+      constexpr operator double() const
+      {
+        return this->toSeconds();
+      }
+
+      /** integer comparison */
+      friend constexpr bool operator == (const Tick &A, const Tick &B)
+      {
+        return A._Count == B._Count;
+      }
+
+      friend constexpr bool operator != (const Tick &A, const Tick &B)
+      {
+        return A._Count != B._Count;
+      }
+
+      friend constexpr bool operator < (const Tick &A, const Tick &B)
+      {
+        return A._Count < B._Count;
+      }
+
+      friend constexpr bool operator <= (const Tick &A, const Tick &B)
+      {
+        return A._Count <= B._Count;
+      }
+
+      friend constexpr bool operator > (const Tick &A, const Tick &B)
+      {
+        return A._Count > B._Count;
+      }
+
+      friend constexpr bool operator >= (const Tick &A, const Tick &B)
+      {
+        return A._Count >= B._Count;
+      }
+
+    private:
+      int64_t _Count;
+  };
+
+  std::ostream& operator << (std::ostream& Os, const Tick& Time);
+}
+
+namespace std
+{
+  template <>
+  struct hash<libRSF::Tick>
+  {
+    size_t operator()(const libRSF::Tick& Object) const
+    {
+      return hash<int64_t>()(Object.count());
+    }
+  };
+}
+
+#endif // TICK_H
@@ -46,6 +46,7 @@ namespace libRSF
   enum class ErrorModelTuningType {None, EM, EM_MAP, VBI};
 
   enum class SolutionType {None, Batch, Smoother, SmootherRT, Window, Filter};
+  enum class WindowPolicy {Remove, Marginalize};
 
   /** types of used factors (Remember to add new types to FactorTypeDict below!) */
   enum class FactorType
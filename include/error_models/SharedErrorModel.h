@@ -0,0 +1,211 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file SharedErrorModel.h
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Wrapper that lets many factors share one immutable error model.
+ * @copyright GNU Public License.
+ *
+ */
+
+#ifndef SHAREDERRORMODEL_H
+#define SHAREDERRORMODEL_H
+
+#include "ErrorModel.h"
+#include "MaxMixture.h"
+#include "SumMixture.h"
+#include "MaxSumMixture.h"
+#include "../VectorTypes.h"
+
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+
+namespace libRSF
+{
+  /** type independent handle of a shared model, the graph publishes new models through it before each solve */
+  class SharedModelState
+  {
+    public:
+      SharedModelState() = default;
+      virtual ~SharedModelState() = default;
+
+      /** make the last stored model visible to the evaluation, must not be called while a solver is running */
+      virtual void pin() = 0;
+  };
+
+  /** \brief Error model that points to a shared snapshot of another error model
+   *
+   * All copies of one SharedErrorModel refer to the same snapshot, so the
+   * factors of a graph do not store a own copy of e.g. a large mixture.
+   * Replacing the model with setModel() is a single pointer swap that
+   * affects all factors at once. The evaluation reads a plain reference,
+   * so a new model becomes visible after pin(), which is called by the
+   * graph before each solve. Enabling and disabling stays per factor.
+   *
+   * \param ModelType Underlying error model, e.g. MaxMix1
+   *
+   */
+  template <typename ModelType>
+  class SharedErrorModel : public ErrorModelBase
+  {
+    private:
+      /** owns the active and the latest model */
+      class Snapshot : public SharedModelState
+      {
+        public:
+          explicit Snapshot(const ModelType &Model): _Active(std::make_shared<const ModelType>(Model)), _Latest(_Active)
+          {}
+
+          /** only replaced by pin() between solves, so the evaluation needs no synchronization */
+          const ModelType& active() const
+          {
+            return *_Active;
+          }
+
+          /** readers keep the model alive until they are done, even if it is replaced in the meantime */
+          std::shared_ptr<const ModelType> latest() const
+          {
+            std::lock_guard<std::mutex> Lock(_Mutex);
+            return _Latest;
+          }
+
+          void store(const ModelType &Model)
+          {
+            std::shared_ptr<const ModelType> New = std::make_shared<const ModelType>(Model);
+            std::lock_guard<std::mutex> Lock(_Mutex);
+            _Latest = std::move(New);
+          }
+
+          void pin() override
+          {
+            std::lock_guard<std::mutex> Lock(_Mutex);
+            _Active = _Latest;
+          }
+
+        private:
+          std::shared_ptr<const ModelType> _Active;
+          std::shared_ptr<const ModelType> _Latest;
+          mutable std::mutex _Mutex;
+      };
+
+    public:
+      /** static access to dimensions*/
+      static const int InputDim = ModelType::InputDim;
+      static const int OutputDim = ModelType::OutputDim;
+
+      /** store the dimension of variables at compile time */
+      using StateDims = typename ModelType::StateDims;
+
+      SharedErrorModel(): _Snapshot(std::make_shared<Snapshot>(ModelType()))
+      {}
+
+      explicit SharedErrorModel(const ModelType &Model): _Snapshot(std::make_shared<Snapshot>(Model))
+      {}
+
+      virtual ~SharedErrorModel() = default;
+
+      /** replace the model of this object and all of its copies, it is used for the evaluation after the next pin() */
+      void setModel(const ModelType &Model)
+      {
+        _Snapshot->store(Model);
+      }
+
+      /** the latest model, it is immutable and stays valid after a replacement */
+      std::shared_ptr<const ModelType> getModel() const
+      {
+        return _Snapshot->latest();
+      }
+
+      /** use the latest model for the evaluation, FactorGraph does this before each solve */
+      void pinModel()
+      {
+        _Snapshot->pin();
+      }
+
+      std::shared_ptr<SharedModelState> getState() const
+      {
+        return _Snapshot;
+      }
+
+      /** check if two objects share the same model */
+      bool isSharedWith(const SharedErrorModel &Other) const
+      {
+        return _Snapshot == Other._Snapshot;
+      }
+
+      /** the last parameter is always the weighted error */
+      template <typename T, typename... ParamTypes>
+      bool weight(const VectorT<T, InputDim> &RawError, ParamTypes... Params) const
+      {
+        if (this->_Enable)
+        {
+          /** replacements are not visible until the next pin(), so a plain reference is enough */
+          return _Snapshot->active().template weight<T>(RawError, Params...);
+        }
+        else
+        {
+          T* Error = std::get<sizeof...(ParamTypes) - 1>(std::forward_as_tuple(Params...));
+
+          /** pass raw error trough */
+          VectorRef<T, InputDim> ErrorMap(Error);
+          ErrorMap = RawError;
+
+          /** set unused dimensions to 0 */
+          for (int n = InputDim; n < OutputDim; ++n)
+          {
+            Error[n] = T(0.0);
+          }
+
+          return true;
+        }
+      }
+
+    private:
+      std::shared_ptr<Snapshot> _Snapshot;
+  };
+
+  /** detect shared models at compile time */
+  template <typename ErrorType>
+  struct IsSharedErrorModel : std::false_type {};
+
+  template <typename ModelType>
+  struct IsSharedErrorModel<SharedErrorModel<ModelType>> : std::true_type {};
+
+  typedef SharedErrorModel<MaxMix1> SharedMaxMix1;
+  typedef SharedErrorModel<MaxMix2> SharedMaxMix2;
+  typedef SharedErrorModel<MaxMix3> SharedMaxMix3;
+
+  typedef SharedErrorModel<SumMix1> SharedSumMix1;
+  typedef SharedErrorModel<SumMix2> SharedSumMix2;
+  typedef SharedErrorModel<SumMix3> SharedSumMix3;
+
+  typedef SharedErrorModel<MaxSumMix1> SharedMaxSumMix1;
+  typedef SharedErrorModel<MaxSumMix2> SharedMaxSumMix2;
+  typedef SharedErrorModel<MaxSumMix3> SharedMaxSumMix3;
+}
+
+#endif // SHAREDERRORMODEL_H
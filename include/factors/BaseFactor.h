@@ -36,6 +36,7 @@
 #include "../Data.h"
 #include "../Types.h"
 #include "../error_models/ErrorModel.h"
+#include "../MemoryPool.h"
 
 using ceres::AutoDiffCostFunction;
 
@@ -49,7 +50,7 @@ namespace libRSF
             bool HasMeasurementTemp,
             bool HasDeltaTimeTemp,
             int... StateDimsTemp>   // Number of parameters
-  class BaseFactor
+  class BaseFactor : public PoolAllocated
   {
     public:
 
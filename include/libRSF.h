@@ -35,10 +35,13 @@
 /** most important functions */
 #include "FactorGraph.h"
 #include "FactorGraphConfig.h"
+#include "EstimationPipeline.h"
+#include "MultiStart.h"
 #include "FileAccess.h"
 #include "Misc.h"
 #include "StateDataSet.h"
 #include "SensorDataSet.h"
+#include "SensorDataSource.h"
 #include "GNSS.h"
 #include "Resampling.h"
 #include "TimeMeasurement.h"
@@ -152,4 +152,104 @@ namespace libRSF
 
     return true;
   }
+
+  bool CalculateCovariance(ceres::Problem &Graph,
+                           StateDataSet &States,
+                           const std::vector<StateID> &StateIDs,
+                           Matrix * const JointCovariance)
+  {
+    /** collect each parameter block only once */
+    std::vector<const double*> ParameterBlocks;
+    std::vector<Data*> Elements;
+    std::unordered_set<const double*> Known;
+    for (const StateID &State : StateIDs)
+    {
+      if (States.checkElement(State.ID, State.Timestamp, State.Number) == false)
+      {
+        PRINT_ERROR("Covariance computation went wrong. State doesn't exist: ", State);
+        return false;
+      }
+
+      Data &Element = States.getElement(State.ID, State.Timestamp, State.Number);
+      if (Known.insert(Element.getMeanPointer()).second)
+      {
+        ParameterBlocks.push_back(Element.getMeanPointer());
+        Elements.push_back(&Element);
+      }
+    }
+
+    if (ParameterBlocks.empty())
+    {
+      PRINT_WARNING("No states for covariance computation!");
+      return false;
+    }
+
+    /** cross-covariances are only requested, if they are required */
+    std::vector<std::pair<const double*, const double*>> CovarianceBlocks;
+    for (size_t n = 0; n < ParameterBlocks.size(); n++)
+    {
+      if (JointCovariance != nullptr)
+      {
+        for (size_t m = n; m < ParameterBlocks.size(); m++)
+        {
+          CovarianceBlocks.emplace_back(ParameterBlocks.at(n), ParameterBlocks.at(m));
+        }
+      }
+      else
+      {
+        CovarianceBlocks.emplace_back(ParameterBlocks.at(n), ParameterBlocks.at(n));
+      }
+    }
+
+    /** create covariance object */
+    ceres::Covariance::Options CovOptions;
+    CovOptions.algorithm_type = ceres::CovarianceAlgorithmType::SPARSE_QR;
+    CovOptions.num_threads = std::thread::hardware_concurrency();
+    CovOptions.apply_loss_function = true;
+    ceres::Covariance CovarianceQR(CovOptions);
+
+    /** the alternative with the more robust SVD */
+    CovOptions.algorithm_type = ceres::CovarianceAlgorithmType::DENSE_SVD;
+    CovOptions.null_space_rank = -1;
+    ceres::Covariance CovarianceSVD(CovOptions);
+
+    /** at first we try the more efficient algorithm */
+    const ceres::Covariance *Covariance = &CovarianceQR;
+    bool Success = CovarianceQR.Compute(CovarianceBlocks, &Graph);
+
+    if (Success == false && Graph.NumParameterBlocks() < 100)
+    {
+      PRINT_WARNING("Jacobian is rank-deficient. Try to compute using SVD.");
+      Covariance = &CovarianceSVD;
+      Success = CovarianceSVD.Compute(CovarianceBlocks, &Graph);
+    }
+
+    if (Success == false)
+    {
+      PRINT_ERROR("Covariance computation of ", ParameterBlocks.size(), " states went wrong.");
+      return false;
+    }
+
+    /** write the marginal covariances directly into the states */
+    for (size_t n = 0; n < ParameterBlocks.size(); n++)
+    {
+      Covariance->GetCovarianceBlock(ParameterBlocks.at(n),
+                                     ParameterBlocks.at(n),
+                                     Elements.at(n)->getDataPointer(DataElement::Covariance));
+    }
+
+    /** assemble the joint covariance, the matrix is row-major as expected by ceres */
+    if (JointCovariance != nullptr)
+    {
+      int Size = 0;
+      for (const double* Block : ParameterBlocks)
+      {
+        Size += Graph.ParameterBlockSize(Block);
+      }
+      JointCovariance->resize(Size, Size);
+      Covariance->GetCovarianceMatrix(ParameterBlocks, JointCovariance->data());
+    }
+
+    return true;
+  }
 }
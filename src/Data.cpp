@@ -30,7 +30,7 @@ namespace libRSF
     this->_Config = &GlobalDataConfig;
   }
 
-  Data::Data(std::string Input)
+  Data::Data(std::string_view Input)
   {
     this->_Config = &GlobalDataConfig;
     this->constructFromString(Input);
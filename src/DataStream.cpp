@@ -27,6 +27,6 @@ namespace libRSF
 {
   double roundToTick(const double Time)
   {
-    return round(Time * 1e3) * 1e-3;
+    return Tick(Time).toSeconds();
   }
 }
@@ -0,0 +1,269 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+#include "EstimationPipeline.h"
+
+namespace libRSF
+{
+  const string EstimationPipeline::TimingName = "SolveTime";
+
+  EstimationPipeline::EstimationPipeline(const FactorGraphConfig &Config, EpochFunction AddEpoch, ResultFunction SaveResult)
+    : _Solution(Config.Solution), _SolverOptions(Config.SolverConfig),
+      _AddEpoch(std::move(AddEpoch)), _SaveResult(std::move(SaveResult)),
+      _CovarianceInterval(1)
+  {}
+
+  void EstimationPipeline::setCovarianceStates(const std::vector<string> &Names, const int Interval)
+  {
+    _CovarianceStates = Names;
+    _CovarianceInterval = std::max(Interval, 1);
+  }
+
+  bool EstimationPipeline::run(FactorGraph &Graph, SensorDataSet &Measurements, StateDataSet &Result)
+  {
+    std::vector<double> Epochs;
+    if (this->getEpochs(Measurements, Epochs) == false)
+    {
+      return false;
+    }
+
+    return this->process(Graph, Measurements, Epochs, Epochs.front(), Result);
+  }
+
+  bool EstimationPipeline::run(FactorGraph &Graph, SensorDataSet &Measurements, const double TimeInitialized, StateDataSet &Result)
+  {
+    std::vector<double> Epochs;
+    if (this->getEpochs(Measurements, Epochs) == false)
+    {
+      return false;
+    }
+
+    /** skip everything that is already part of the graph */
+    Epochs.erase(Epochs.begin(), std::upper_bound(Epochs.begin(), Epochs.end(), TimeInitialized));
+
+    return this->process(Graph, Measurements, Epochs, TimeInitialized, Result);
+  }
+
+  const StateDataSet& EstimationPipeline::getTiming() const
+  {
+    return _Timing;
+  }
+
+  bool EstimationPipeline::process(FactorGraph &Graph, SensorDataSet &Measurements, const std::vector<double> &Epochs, double TimeOld, StateDataSet &Result)
+  {
+    this->prepareGraph(Graph);
+
+    const bool SolveEachEpoch = (_Solution.Type != SolutionType::Batch && _Solution.Type != SolutionType::None);
+
+    int Epoch = 0;
+    for (const double TimeNow : Epochs)
+    {
+      Timer EpochTimer;
+
+      _AddEpoch(Graph, Measurements, TimeOld, TimeNow);
+
+      if (SolveEachEpoch)
+      {
+        Graph.solve(_SolverOptions);
+        this->estimateCovariance(Graph, TimeNow, Epoch);
+        _SaveResult(Graph, TimeNow, Result);
+        this->applyWindow(Graph, TimeOld, TimeNow);
+      }
+      else if (_Solution.Type == SolutionType::None)
+      {
+        _SaveResult(Graph, TimeNow, Result);
+      }
+
+      /** bounded memory for long running applications, see DataSet::setRetentionPolicy() */
+      Measurements.applyRetentionPolicy(TimeNow);
+      Result.applyRetentionPolicy(TimeNow);
+
+      this->storeTiming(Graph, TimeNow, EpochTimer);
+
+      TimeOld = TimeNow;
+      Epoch++;
+    }
+
+    /** batch: solve once after everything is added */
+    if (_Solution.Type == SolutionType::Batch && Epochs.empty() == false)
+    {
+      Timer BatchTimer;
+
+      Graph.solve(_SolverOptions);
+      if (_Solution.EstimateCov)
+      {
+        std::vector<StateID> States;
+        for (const string &Name : _CovarianceStates)
+        {
+          for (const double TimeNow : Epochs)
+          {
+            const int Numbers = Graph.getStateData().countElement(Name, TimeNow);
+            for (int n = 0; n < Numbers; n++)
+            {
+              States.emplace_back(StateID(Name, TimeNow, n));
+            }
+          }
+        }
+        Graph.computeCovariances(States);
+      }
+
+      for (const double TimeNow : Epochs)
+      {
+        _SaveResult(Graph, TimeNow, Result);
+      }
+      Result.applyRetentionPolicy(Epochs.back());
+
+      this->storeTiming(Graph, Epochs.back(), BatchTimer);
+    }
+
+    return true;
+  }
+
+  bool EstimationPipeline::getEpochs(const SensorDataSet &Measurements, std::vector<double> &Epochs) const
+  {
+    Epochs.clear();
+
+    if (_Solution.IsAsync)
+    {
+      /** fixed rate over the complete data set */
+      if (_Solution.AsyncRate <= 0.0)
+      {
+        PRINT_ERROR("Asynchronous rate has to be positive: ", _Solution.AsyncRate);
+        return false;
+      }
+
+      double TimeFirst, TimeLast;
+      if (!Measurements.getTimeFirstOverall(TimeFirst) || !Measurements.getTimeLastOverall(TimeLast))
+      {
+        PRINT_ERROR("There are no measurements!");
+        return false;
+      }
+
+      const double Step = 1.0 / _Solution.AsyncRate;
+      const int Number = static_cast<int>(std::floor((TimeLast - TimeFirst) / Step)) + 1;
+      Epochs.reserve(Number);
+      for (int n = 0; n < Number; n++)
+      {
+        Epochs.emplace_back(roundToTick(TimeFirst + n * Step));
+      }
+    }
+    else
+    {
+      /** every measurement of the synchronizing sensor */
+      double Time;
+      if (!Measurements.getTimeFirst(_Solution.SyncSensor, Time))
+      {
+        PRINT_ERROR("There are no measurements of the synchronizing sensor: ", _Solution.SyncSensor);
+        return false;
+      }
+
+      do
+      {
+        Epochs.emplace_back(Time);
+      }
+      while (Measurements.getTimeNext(_Solution.SyncSensor, Time, Time));
+    }
+
+    return true;
+  }
+
+  void EstimationPipeline::prepareGraph(FactorGraph &Graph) const
+  {
+    switch (_Solution.Type)
+    {
+      case SolutionType::Smoother:
+        if (_Solution.EstimateCov)
+        {
+          PRINT_WARNING("Covariances are not estimated by the incremental smoother!");
+        }
+        Graph.setSmootherMode(true);
+        break;
+
+      case SolutionType::SmootherRT:
+        Graph.setIncrementalMode(true, _Solution.WindowLength);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void EstimationPipeline::applyWindow(FactorGraph &Graph, const double TimeOld, const double TimeNow) const
+  {
+    switch (_Solution.Type)
+    {
+      case SolutionType::Window:
+        Graph.slideWindow(TimeNow, _Solution.WindowLength, _Solution.Marginalize ? WindowPolicy::Marginalize : WindowPolicy::Remove);
+        break;
+
+      case SolutionType::Filter:
+        /** only the newest states remain */
+        if (TimeNow > TimeOld)
+        {
+          Graph.slideWindow(TimeNow, TimeNow - TimeOld, WindowPolicy::Marginalize);
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void EstimationPipeline::estimateCovariance(FactorGraph &Graph, const double TimeNow, const int Epoch) const
+  {
+    if (_Solution.EstimateCov == false || _Solution.Type == SolutionType::Smoother || Epoch % _CovarianceInterval != 0)
+    {
+      return;
+    }
+
+    /** all states of this epoch share one factorization */
+    std::vector<StateID> States;
+    for (const string &Name : _CovarianceStates)
+    {
+      const int Numbers = Graph.getStateData().countElement(Name, TimeNow);
+      for (int n = 0; n < Numbers; n++)
+      {
+        States.emplace_back(StateID(Name, TimeNow, n));
+      }
+    }
+
+    if (States.empty() == false)
+    {
+      Graph.computeCovariances(States);
+    }
+  }
+
+  void EstimationPipeline::storeTiming(FactorGraph &Graph, const double TimeNow, Timer &EpochTimer)
+  {
+    /** the window duration contains the marginalization, if it was triggered by the window */
+    const double MarginalDuration = Graph.getMarginalDurationAndReset();
+    const double WindowDuration = Graph.getWindowDurationAndReset();
+
+    Data Summary(DataType::IterationSummary, TimeNow);
+    Summary.setValueScalar(DataElement::DurationTotal, EpochTimer.getSeconds());
+    Summary.setValueScalar(DataElement::DurationSolver, Graph.getSolverDurationAndReset());
+    Summary.setValueScalar(DataElement::DurationMarginal, std::max(MarginalDuration, WindowDuration));
+    Summary.setValueScalar(DataElement::IterationSolver, Graph.getSolverIterationsAndReset());
+    _Timing.addElement(TimingName, Summary);
+  }
+}
@@ -40,18 +40,38 @@ namespace libRSF
     _List.clear();
   }
 
-  FactorGraph::FactorGraph() : _Graph(this->_DefaultProblemOptions), _Structure(&_Graph, &_StateData), _SolverDuration(0.0), _SolverIterations(0), _MarginalizationDuration(0.0)
+  FactorGraph::FactorGraph() : _Graph(this->_DefaultProblemOptions), _Structure(&_Graph, &_StateData), _SolverDuration(0.0), _SolverIterations(0), _MarginalizationDuration(0.0), _WindowDuration(0.0), _MarginalizationType(MarginalizationType::Sparse),
+                               _IncrementalMode(false), _ActiveWindow(std::numeric_limits<double>::infinity()), _SkipUnchanged(false), _Modified(true),
+                               _ConstantBoundary(Tick::FromCount(std::numeric_limits<int64_t>::lowest())),
+                               _SmootherMode(false), _SmootherRelinearizeAll(false), _RelinearizationThreshold(0.01), _MaxPropagationSteps(5)
   {}
 
+  FactorGraph::~FactorGraph()
+  {
+    /** the solver thread works on our members */
+    if (_SolverFuture.valid())
+    {
+      _SolverFuture.wait();
+    }
+  }
+
   void FactorGraph::solve()
   {
+    /** finish a running solve and merge everything that arrived in the meantime */
+    this->waitForSolver();
+    this->pinSharedModels();
+
     /** check if config is valid */
     std::string OptionsError;
     if (_SolverOptions.IsValid(&OptionsError) == false)
     {
       PRINT_ERROR("The given solver options are wrong: ", OptionsError);
     }
-    else
+    else if (_SmootherMode)
+    {
+      this->solveSmoother();
+    }
+    else if (this->prepareIncrementalSolve())
     {
       /** call ceres to solve the optimization problem */
       ceres::Solve(_SolverOptions, &_Graph, &_Report);
@@ -62,10 +82,408 @@ namespace libRSF
 
   void FactorGraph::solve(ceres::Solver::Options Options)
   {
+    this->waitForSolver();
     _SolverOptions = Options;
     this->solve();
   }
 
+  std::shared_future<bool> FactorGraph::solveAsync()
+  {
+    /** do not block the caller, if the last solve is not finished */
+    if (this->isSolving())
+    {
+      return _SolverFuture;
+    }
+
+    /** solve boundary: merge the staged modifications and replaced error models */
+    this->applyStaged();
+    this->pinSharedModels();
+
+    /** the last solution is still valid */
+    if (_SmootherMode == false && this->prepareIncrementalSolve() == false)
+    {
+      std::promise<bool> Skipped;
+      Skipped.set_value(true);
+      _SolverFuture = Skipped.get_future().share();
+      return _SolverFuture;
+    }
+
+    /** check if config is valid */
+    std::string OptionsError;
+    if (_SolverOptions.IsValid(&OptionsError) == false)
+    {
+      PRINT_ERROR("The given solver options are wrong: ", OptionsError);
+
+      std::promise<bool> Failed;
+      Failed.set_value(false);
+      _SolverFuture = Failed.get_future().share();
+      return _SolverFuture;
+    }
+
+    /** only the solver thread touches the problem until the future is ready */
+    _SolverFuture = std::async(std::launch::async, [this]()
+    {
+      if (_SmootherMode)
+      {
+        const bool Success = this->solveSmoother();
+        this->publishSnapshot();
+        return Success;
+      }
+
+      ceres::Solve(_SolverOptions, &_Graph, &_Report);
+      _SolverDuration += _Report.total_time_in_seconds;
+      _SolverIterations += _Report.num_successful_steps + _Report.num_unsuccessful_steps;
+      this->publishSnapshot();
+      return _Report.IsSolutionUsable();
+    }).share();
+
+    return _SolverFuture;
+  }
+
+  std::shared_future<bool> FactorGraph::solveAsync(ceres::Solver::Options Options)
+  {
+    if (this->isSolving())
+    {
+      return _SolverFuture;
+    }
+
+    _SolverOptions = Options;
+    return this->solveAsync();
+  }
+
+  bool FactorGraph::isSolving() const
+  {
+    return _SolverFuture.valid() && _SolverFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+  }
+
+  void FactorGraph::waitForSolver()
+  {
+    if (_SolverFuture.valid())
+    {
+      _SolverFuture.wait();
+    }
+    this->applyStaged();
+  }
+
+  void FactorGraph::setIncrementalMode(const bool Enable, const double ActiveWindow, const bool SkipUnchanged)
+  {
+    this->waitForSolver();
+
+    if (Enable && _SmootherMode)
+    {
+      PRINT_WARNING("Smoother mode is disabled by the incremental mode!");
+      this->setSmootherMode(false);
+    }
+
+    /** release the states that were held constant by the active window, constant states of the user are kept */
+    this->releaseAllConstant();
+    _ConstantBoundary = Tick::FromCount(std::numeric_limits<int64_t>::lowest());
+
+    _IncrementalMode = Enable;
+    _ActiveWindow = ActiveWindow;
+    _SkipUnchanged = SkipUnchanged;
+    _Modified = true;
+    _Structure.resetChanges();
+    _Report = ceres::Solver::Summary();
+  }
+
+  void FactorGraph::setSmootherMode(const bool Enable, const double RelinearizationThreshold, const int MaxPropagationSteps)
+  {
+    this->waitForSolver();
+
+    /** the smoother manages which states are constant */
+    if (Enable && _IncrementalMode)
+    {
+      PRINT_WARNING("Incremental mode is disabled by the smoother!");
+      this->setIncrementalMode(false);
+    }
+
+    /** the smoother keeps all states constant between updates */
+    if (_SmootherMode && Enable == false)
+    {
+      this->setAllStatesConstant(false);
+    }
+
+    _SmootherMode = Enable;
+    _SmootherRelinearizeAll = Enable;
+    _RelinearizationThreshold = RelinearizationThreshold;
+    _MaxPropagationSteps = MaxPropagationSteps;
+    _NewStates.clear();
+    _Structure.resetChanges();
+  }
+
+  void FactorGraph::setAllStatesConstant(const bool Constant)
+  {
+    /** only states that were made constant by the smoother are released */
+    if (Constant == false)
+    {
+      this->releaseAllConstant();
+      return;
+    }
+
+    for (const string &Name : _StateData.getKeysAll())
+    {
+      for (auto &&Element : *_StateData.getStream(Name))
+      {
+        this->holdConstant(Element.second.getMeanPointer());
+      }
+    }
+  }
+
+  bool FactorGraph::solveSmoother()
+  {
+    const FactorGraphStructure::Changes &Changes = _Structure.getChanges();
+
+    /** removed factors change the information of the remaining states in an unknown way */
+    if (_SmootherRelinearizeAll || Changes.RemovedFactors > 0 || Changes.RemovedStates > 0)
+    {
+      this->setAllStatesConstant(false);
+      ceres::Solve(_SolverOptions, &_Graph, &_Report);
+      _SolverDuration += _Report.total_time_in_seconds;
+      _SolverIterations += _Report.num_successful_steps + _Report.num_unsuccessful_steps;
+      this->setAllStatesConstant(true);
+
+      _SmootherRelinearizeAll = false;
+      _NewStates.clear();
+      _Structure.resetChanges();
+      return _Report.IsSolutionUsable();
+    }
+
+    /** new states and states of new factors are affected */
+    std::vector<double*> Affected = _NewStates;
+    Affected.insert(Affected.end(), Changes.ConnectedStates.begin(), Changes.ConnectedStates.end());
+    _NewStates.clear();
+    _Structure.resetChanges();
+
+    std::unordered_set<double*> Variable;
+    bool Success = true;
+    for (int Step = 0; Step <= _MaxPropagationSteps && Affected.empty() == false; Step++)
+    {
+      /** release affected states and keep their linearization point */
+      std::vector<std::pair<double*, Vector>> Released;
+      for (double* const StatePointer : Affected)
+      {
+        /** states that were set constant by the user are never released */
+        if (_Graph.HasParameterBlock(StatePointer) == false ||
+            (_Graph.IsParameterBlockConstant(StatePointer) && _HeldConstant.count(StatePointer) == 0))
+        {
+          continue;
+        }
+
+        if (Variable.insert(StatePointer).second)
+        {
+          this->releaseConstant(StatePointer);
+          Released.emplace_back(StatePointer, Eigen::Map<const Vector>(StatePointer, _Graph.ParameterBlockSize(StatePointer)));
+        }
+      }
+      Affected.clear();
+
+      if (Released.empty())
+      {
+        break;
+      }
+
+      /** solve the sub-problem */
+      ceres::Solve(_SolverOptions, &_Graph, &_Report);
+      _SolverDuration += _Report.total_time_in_seconds;
+      _SolverIterations += _Report.num_successful_steps + _Report.num_unsuccessful_steps;
+      Success = _Report.IsSolutionUsable();
+
+      /** fluid relinearization: neighbors of states with large updates are affected as well */
+      for (const auto &State : Released)
+      {
+        const Vector Delta = Eigen::Map<const Vector>(State.first, State.second.size()) - State.second;
+        if (Delta.norm() > _RelinearizationThreshold)
+        {
+          std::vector<ceres::ResidualBlockId> Factors;
+          _Graph.GetResidualBlocksForParameterBlock(State.first, &Factors);
+          for (const ceres::ResidualBlockId Factor : Factors)
+          {
+            std::vector<double*> Neighbors;
+            _Graph.GetParameterBlocksForResidualBlock(Factor, &Neighbors);
+            for (double* const Neighbor : Neighbors)
+            {
+              if (Variable.count(Neighbor) == 0)
+              {
+                Affected.emplace_back(Neighbor);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /** hold everything constant until the next update */
+    for (double* const StatePointer : Variable)
+    {
+      this->holdConstant(StatePointer);
+    }
+
+    return Success;
+  }
+
+  const FactorGraphStructure::Changes& FactorGraph::getChangesSinceSolve() const
+  {
+    return _Structure.getChanges();
+  }
+
+  bool FactorGraph::prepareIncrementalSolve()
+  {
+    if (_IncrementalMode == false)
+    {
+      _Structure.resetChanges();
+      return true;
+    }
+
+    /** nothing changed after a converged solve, so the solution is still valid */
+    if (_SkipUnchanged && _Modified == false && _Structure.getChanges().empty() && _Report.termination_type == ceres::CONVERGENCE)
+    {
+      return false;
+    }
+    _Structure.resetChanges();
+    _Modified = false;
+
+    /** move the constant boundary forward, only states that crossed it since the last solve are touched */
+    if (_StateQueue.empty() == false && std::isfinite(_ActiveWindow))
+    {
+      const Tick Boundary(_StateQueue.rbegin()->first - _ActiveWindow);
+      if (Boundary > _ConstantBoundary)
+      {
+        const auto End = _StateQueue.upper_bound(Boundary);
+        for (auto It = _StateQueue.upper_bound(_ConstantBoundary); It != End; ++It)
+        {
+          for (const string &Name : It->second)
+          {
+            const int Numbers = _StateData.countElement(Name, It->first);
+            for (int n = 0; n < Numbers; n++)
+            {
+              this->holdConstant(_StateData.getElement(Name, It->first, n).getMeanPointer());
+            }
+          }
+        }
+        _ConstantBoundary = Boundary;
+      }
+    }
+
+    return true;
+  }
+
+  void FactorGraph::holdConstant(double* const StatePointer)
+  {
+    if (_Graph.IsParameterBlockConstant(StatePointer) == false)
+    {
+      _Graph.SetParameterBlockConstant(StatePointer);
+      _HeldConstant.insert(StatePointer);
+    }
+  }
+
+  void FactorGraph::releaseConstant(double* const StatePointer)
+  {
+    if (_HeldConstant.erase(StatePointer) > 0)
+    {
+      _Graph.SetParameterBlockVariable(StatePointer);
+    }
+  }
+
+  void FactorGraph::releaseAllConstant()
+  {
+    for (double* const StatePointer : _HeldConstant)
+    {
+      _Graph.SetParameterBlockVariable(StatePointer);
+    }
+    _HeldConstant.clear();
+  }
+
+  void FactorGraph::removeParameterBlock(double* const StatePointer)
+  {
+    /** the cached covariance prior depends on its states, a new state with the same ID must not reuse it */
+    for (const StateID &State : _CovarianceStates)
+    {
+      if (_StateData.checkElement(State.ID, State.Timestamp, State.Number) &&
+          _StateData.getElement(State.ID, State.Timestamp, State.Number).getMeanPointer() == StatePointer)
+      {
+        this->resetCovarianceCache();
+        break;
+      }
+    }
+
+    _HeldConstant.erase(StatePointer);
+    _Graph.RemoveParameterBlock(StatePointer);
+  }
+
+  void FactorGraph::registerSharedModel(const std::shared_ptr<SharedModelState> &State)
+  {
+    /** there are only a few distinct shared models, so a linear search is fine */
+    for (const std::weak_ptr<SharedModelState> &Known : _SharedModels)
+    {
+      if (Known.lock() == State)
+      {
+        return;
+      }
+    }
+    _SharedModels.emplace_back(State);
+  }
+
+  void FactorGraph::pinSharedModels()
+  {
+    /** models of removed factors might be gone already */
+    _SharedModels.erase(std::remove_if(_SharedModels.begin(), _SharedModels.end(),
+                                       [](const std::weak_ptr<SharedModelState> &State){return State.expired();}),
+                        _SharedModels.end());
+
+    for (const std::weak_ptr<SharedModelState> &State : _SharedModels)
+    {
+      if (const std::shared_ptr<SharedModelState> Locked = State.lock())
+      {
+        Locked->pin();
+      }
+    }
+  }
+
+  void FactorGraph::stage(std::function<void(FactorGraph&)> Modification)
+  {
+    if (this->isSolving())
+    {
+      std::lock_guard<std::mutex> Lock(_StagedMutex);
+      _Staged.emplace_back(std::move(Modification));
+    }
+    else
+    {
+      /** apply older modifications first to keep the order */
+      this->applyStaged();
+      Modification(*this);
+    }
+  }
+
+  void FactorGraph::applyStaged()
+  {
+    std::vector<std::function<void(FactorGraph&)>> Staged;
+    {
+      std::lock_guard<std::mutex> Lock(_StagedMutex);
+      Staged.swap(_Staged);
+    }
+
+    for (auto &Modification : Staged)
+    {
+      Modification(*this);
+    }
+  }
+
+  void FactorGraph::publishSnapshot()
+  {
+    /** copy outside of the lock, so readers are only blocked by the pointer swap */
+    std::shared_ptr<const StateDataSet> Snapshot = std::make_shared<const StateDataSet>(_StateData);
+
+    std::lock_guard<std::mutex> Lock(_SnapshotMutex);
+    _Snapshot.swap(Snapshot);
+  }
+
+  std::shared_ptr<const StateDataSet> FactorGraph::getStateSnapshot() const
+  {
+    std::lock_guard<std::mutex> Lock(_SnapshotMutex);
+    return _Snapshot;
+  }
+
   void FactorGraph::addState(string Name, DataType Type, double Timestamp)
   {
     Data Element(Type, Timestamp);
@@ -85,7 +503,7 @@ namespace libRSF
     switch (_StateData.getElement(Name, Timestamp, StateNumber).getType())
     {
       case DataType::Angle:
-        _Graph.AddParameterBlock(StatePointer, StateSize, AngleLocalParameterization::Create());
+        _Graph.AddParameterBlock(StatePointer, StateSize, this->getLocalParameterization(DataType::Angle));
         break;
 
       case DataType::UnitCircle:
@@ -95,7 +513,7 @@ namespace libRSF
           Circle << 1, 0;
           _StateData.getElement(Name, Timestamp, StateNumber).setMean(Circle);
 
-          _Graph.AddParameterBlock(StatePointer, StateSize, UnitCircleLocalParameterization::Create());
+          _Graph.AddParameterBlock(StatePointer, StateSize, this->getLocalParameterization(DataType::UnitCircle));
           break;
         }
 
@@ -106,16 +524,13 @@ namespace libRSF
           Quat << 0, 0, 0, 1; /**< x,y,z,w */
           _StateData.getElement(Name, Timestamp, StateNumber).setMean(Quat);
 
-          _Graph.AddParameterBlock(StatePointer, StateSize, QuaternionLocalParameterization::Create());
+          _Graph.AddParameterBlock(StatePointer, StateSize, this->getLocalParameterization(DataType::Quaternion));
           break;
         }
 
       case DataType::Pose2:
-        {
-          ceres::LocalParameterization *LocalParamPose2 = new ceres::ProductParameterization(new ceres::IdentityParameterization(2), AngleLocalParameterization::Create());
-          _Graph.AddParameterBlock(StatePointer, StateSize, LocalParamPose2);
-          break;
-        }
+        _Graph.AddParameterBlock(StatePointer, StateSize, this->getLocalParameterization(DataType::Pose2));
+        break;
 
       case DataType::Pose3:
         {
@@ -124,8 +539,7 @@ namespace libRSF
           Pose3 << 0,0,0, 0,0,0,1;
           _StateData.getElement(Name, Timestamp, StateNumber).setMean(Pose3);
 
-          ceres::LocalParameterization *LocalParamPose3 = new ceres::ProductParameterization(new ceres::IdentityParameterization(3), QuaternionLocalParameterization::Create());
-          _Graph.AddParameterBlock(StatePointer, StateSize, LocalParamPose3);
+          _Graph.AddParameterBlock(StatePointer, StateSize, this->getLocalParameterization(DataType::Pose3));
           break;
         }
 
@@ -146,6 +560,22 @@ namespace libRSF
         _Graph.AddParameterBlock(StatePointer, StateSize);
         break;
     }
+
+    /** new states are optimized by the next smoother update */
+    if (_SmootherMode)
+    {
+      _NewStates.emplace_back(StatePointer);
+    }
+
+    /** remember the first state at this timestamp for the sliding window */
+    if (StateNumber == 0)
+    {
+      std::vector<string> &Names = _StateQueue[Tick(Timestamp)];
+      if (std::find(Names.begin(), Names.end(), Name) == Names.end())
+      {
+        Names.emplace_back(Name);
+      }
+    }
   }
 
   void FactorGraph::addStateWithCheck(string Name, DataType Type, double Timestamp)
@@ -186,22 +616,78 @@ namespace libRSF
   {
     for (int StateNumber = _StateData.countElement(Name, Timestamp); StateNumber > 0; --StateNumber)
     {
-      _Graph.SetParameterBlockConstant(_StateData.getElement(Name, Timestamp, StateNumber - 1).getMeanPointer());
+      /** the user owns this state now, so it is not released by the incremental modes */
+      double* const StatePointer = _StateData.getElement(Name, Timestamp, StateNumber - 1).getMeanPointer();
+      _Graph.SetParameterBlockConstant(StatePointer);
+      _HeldConstant.erase(StatePointer);
     }
+    _Modified = true;
   }
 
   void FactorGraph::setVariable(string Name, double Timestamp)
   {
     for (int StateNumber = _StateData.countElement(Name, Timestamp); StateNumber > 0; --StateNumber)
     {
-      _Graph.SetParameterBlockVariable(_StateData.getElement(Name, Timestamp, StateNumber - 1).getMeanPointer());
+      double* const StatePointer = _StateData.getElement(Name, Timestamp, StateNumber - 1).getMeanPointer();
+      _Graph.SetParameterBlockVariable(StatePointer);
+      _HeldConstant.erase(StatePointer);
     }
+    _Modified = true;
   }
 
   void FactorGraph::setSubsetConstant(string Name, double Timestamp, int Number, const std::vector<int> &ConstantIndex)
   {
     _Graph.SetParameterization(_StateData.getElement(Name, Timestamp, Number).getMeanPointer(),
-                               new ceres::SubsetParameterization(_StateData.getElement(Name, Timestamp, Number).getMean().size(), ConstantIndex));
+                               this->getSubsetParameterization(_StateData.getElement(Name, Timestamp, Number).getMean().size(), ConstantIndex));
+    _Modified = true;
+  }
+
+  ceres::LocalParameterization* FactorGraph::getLocalParameterization(const DataType Type)
+  {
+    /** create on first use */
+    std::unique_ptr<ceres::LocalParameterization> &LocalParam = _LocalParameterizations[Type];
+    if (!LocalParam)
+    {
+      switch (Type)
+      {
+        case DataType::Angle:
+          LocalParam.reset(AngleLocalParameterization::Create());
+          break;
+
+        case DataType::UnitCircle:
+          LocalParam.reset(UnitCircleLocalParameterization::Create());
+          break;
+
+        case DataType::Quaternion:
+          LocalParam.reset(QuaternionLocalParameterization::Create());
+          break;
+
+        case DataType::Pose2:
+          LocalParam.reset(new ceres::ProductParameterization(new ceres::IdentityParameterization(2), AngleLocalParameterization::Create()));
+          break;
+
+        case DataType::Pose3:
+          LocalParam.reset(new ceres::ProductParameterization(new ceres::IdentityParameterization(3), QuaternionLocalParameterization::Create()));
+          break;
+
+        default:
+          PRINT_ERROR("There is no local parametrization for type: ", Type);
+          break;
+      }
+    }
+
+    return LocalParam.get();
+  }
+
+  ceres::LocalParameterization* FactorGraph::getSubsetParameterization(const int Size, const std::vector<int> &ConstantIndex)
+  {
+    std::unique_ptr<ceres::LocalParameterization> &LocalParam = _SubsetParameterizations[std::make_pair(Size, ConstantIndex)];
+    if (!LocalParam)
+    {
+      LocalParam.reset(new ceres::SubsetParameterization(Size, ConstantIndex));
+    }
+
+    return LocalParam.get();
   }
 
   void FactorGraph::setUpperBound(const string &Name, const double Timestamp, const int StateNumber, const Vector &Bound)
@@ -251,6 +737,7 @@ namespace libRSF
     }
 
     std::vector<double*> MarginalStates;
+    std::vector<int> MarginalBlockSizes;
     int MarginalSize = 0;
     for (const StateID &State : States)
     {
@@ -265,7 +752,8 @@ namespace libRSF
       MarginalStates.push_back(_StateData.getElement(State.ID, State.Timestamp, State.Number).getMeanPointer());
 
       /** compute size of the marginalized system */
-      MarginalSize += _Graph.ParameterBlockLocalSize(MarginalStates.back());
+      MarginalBlockSizes.push_back(_Graph.ParameterBlockLocalSize(MarginalStates.back()));
+      MarginalSize += MarginalBlockSizes.back();
     }
 
     /** get connected states */
@@ -301,14 +789,22 @@ namespace libRSF
       /** map error to vector */
       Vector Residuals = Eigen::Map<Vector, Eigen::Unaligned>(ResidualVec.data(), ResidualVec.size());
 
-      /** convert into eigen matrix */
-      Matrix Jacobian;
-      CRSToMatrix(JacobianCRS, Jacobian);
-
       /** compute marginalization */
       Matrix JacobianMarg;
       Vector ResidualMarg;
-      Marginalize(Residuals, Jacobian, ResidualMarg, JacobianMarg, MarginalSize, Inflation);
+      if (_MarginalizationType == MarginalizationType::Sparse)
+      {
+        /** work directly on the sparse Jacobian */
+        MarginalizeSparse(Residuals, JacobianCRS, ResidualMarg, JacobianMarg, MarginalBlockSizes, Inflation);
+      }
+      else
+      {
+        /** convert into eigen matrix */
+        Matrix Jacobian;
+        CRSToMatrix(JacobianCRS, Jacobian);
+
+        Marginalize(Residuals, Jacobian, ResidualMarg, JacobianMarg, MarginalSize, Inflation);
+      }
 
       /** store original states */
       std::vector<Vector> OriginalStates;
@@ -405,6 +901,11 @@ namespace libRSF
     return this->marginalizeStates(States, Inflation);
   }
 
+  void FactorGraph::setMarginalizationType(const MarginalizationType Type)
+  {
+    _MarginalizationType = Type;
+  }
+
   bool FactorGraph::computeCovariance(const string Name, const double Timestamp)
   {
     return CalculateCovariance(_Graph, _StateData, Name, Timestamp);
@@ -415,6 +916,262 @@ namespace libRSF
     return CalculateCovariance(_Graph, _StateData, Name);
   }
 
+  bool FactorGraph::computeCovariances(const std::vector<StateID> &States)
+  {
+    return CalculateCovariance(_Graph, _StateData, States);
+  }
+
+  bool FactorGraph::computeCovariances(const std::vector<StateID> &States, Matrix &JointCovariance)
+  {
+    return CalculateCovariance(_Graph, _StateData, States, &JointCovariance);
+  }
+
+  void FactorGraph::resetCovarianceCache()
+  {
+    _CovarianceStates.clear();
+    _CovarianceSizes.clear();
+    _CovarianceSqrtInfo.resize(0, 0);
+    _CovarianceRevision = 0;
+  }
+
+  void FactorGraph::evaluateJacobian(const std::vector<ceres::ResidualBlockId> &Factors, const std::vector<double*> &States, Matrix &Jacobian)
+  {
+    ceres::Problem::EvaluateOptions Options;
+    Options.apply_loss_function = true;
+    Options.num_threads = std::thread::hardware_concurrency();
+    Options.parameter_blocks = States;
+    Options.residual_blocks = Factors;
+
+    ceres::CRSMatrix JacobianCRS;
+    _Graph.Evaluate(Options, nullptr, nullptr, nullptr, &JacobianCRS);
+    CRSToMatrix(JacobianCRS, Jacobian);
+  }
+
+  bool FactorGraph::computeCovariancesRecursive(const std::vector<StateID> &States)
+  {
+    /** collect the newest states */
+    std::vector<double*> Newest;
+    std::vector<StateID> NewestIDs;
+    std::vector<int> NewestSizes;
+    std::vector<Data*> NewestData;
+    std::unordered_set<const double*> IsNewest;
+    for (const StateID &State : States)
+    {
+      if (_StateData.checkElement(State.ID, State.Timestamp, State.Number) == false)
+      {
+        PRINT_ERROR("State doesn't exist at: ", State.Timestamp, " Type: ", State.ID, " Number: ", State.Number);
+        return false;
+      }
+
+      Data &Element = _StateData.getElement(State.ID, State.Timestamp, State.Number);
+      if (IsNewest.insert(Element.getMeanPointer()).second)
+      {
+        Newest.push_back(Element.getMeanPointer());
+        NewestIDs.push_back(State);
+        NewestSizes.push_back(_Graph.ParameterBlockLocalSize(Newest.back()));
+        NewestData.push_back(&Element);
+      }
+    }
+
+    if (Newest.empty())
+    {
+      PRINT_WARNING("No states for covariance computation!");
+      return false;
+    }
+
+    /** the same states again are only valid, if nothing was added or removed in between */
+    if (NewestIDs == _CovarianceStates && _Structure.getRevision() != _CovarianceRevision)
+    {
+      this->resetCovarianceCache();
+    }
+
+    /** the cached states are still part of the graph, because removing one of them resets the cache */
+    std::vector<double*> Cached;
+    for (const StateID &State : _CovarianceStates)
+    {
+      Cached.push_back(_StateData.getElement(State.ID, State.Timestamp, State.Number).getMeanPointer());
+    }
+
+    /** information matrix of the newest states */
+    Matrix Information;
+    if (NewestIDs == _CovarianceStates)
+    {
+      /** same epoch again, the cache contains everything */
+      Information = _CovarianceSqrtInfo.transpose() * _CovarianceSqrtInfo;
+    }
+    else if (_CovarianceStates.empty())
+    {
+      /** without cache, all other states of the problem are eliminated once */
+      std::vector<double*> Order;
+      std::vector<int> MarginalBlockSizes;
+      _Graph.GetParameterBlocks(&Order);
+      Order.erase(std::remove_if(Order.begin(), Order.end(), [&IsNewest](const double* State){return IsNewest.count(State) > 0;}), Order.end());
+      for (const double* State : Order)
+      {
+        MarginalBlockSizes.push_back(_Graph.ParameterBlockLocalSize(State));
+      }
+      const bool HasMarginal = (Order.empty() == false);
+      Order.insert(Order.end(), Newest.begin(), Newest.end());
+
+      ceres::Problem::EvaluateOptions Options;
+      Options.apply_loss_function = true;
+      Options.num_threads = std::thread::hardware_concurrency();
+      Options.parameter_blocks = Order;
+
+      ceres::CRSMatrix JacobianCRS;
+      _Graph.Evaluate(Options, nullptr, nullptr, nullptr, &JacobianCRS);
+
+      if (HasMarginal)
+      {
+        Vector ResidualMarg;
+        Matrix JacobianMarg;
+        MarginalizeSparse(Vector::Zero(JacobianCRS.num_rows), JacobianCRS, ResidualMarg, JacobianMarg, MarginalBlockSizes);
+        Information = JacobianMarg.transpose() * JacobianMarg;
+      }
+      else
+      {
+        Matrix Jacobian;
+        CRSToMatrix(JacobianCRS, Jacobian);
+        Information = Jacobian.transpose() * Jacobian;
+      }
+    }
+    else
+    {
+      /** states that remain from the last epoch (e.g. a persistent bias) are already part of the cached prior */
+      const std::unordered_set<const double*> IsCached(Cached.begin(), Cached.end());
+
+      /** only factors that are connected to a state, which was not cached, are new, all older ones are part of the cached prior */
+      std::vector<ceres::ResidualBlockId> Factors;
+      std::vector<double*> FactorStates;
+      std::unordered_set<ceres::ResidualBlockId> KnownFactors;
+      std::unordered_set<double*> KnownStates;
+      for (const double* State : Newest)
+      {
+        if (IsCached.count(State) > 0)
+        {
+          continue;
+        }
+
+        std::vector<ceres::ResidualBlockId> StateFactors;
+        _Graph.GetResidualBlocksForParameterBlock(State, &StateFactors);
+        for (const ceres::ResidualBlockId Factor : StateFactors)
+        {
+          if (KnownFactors.insert(Factor).second == false)
+          {
+            continue;
+          }
+          Factors.push_back(Factor);
+
+          std::vector<double*> Connected;
+          _Graph.GetParameterBlocksForResidualBlock(Factor, &Connected);
+          for (double* const ConnectedState : Connected)
+          {
+            if (KnownStates.insert(ConnectedState).second)
+            {
+              FactorStates.push_back(ConnectedState);
+            }
+          }
+        }
+      }
+
+      /** column order: eliminated states first, newest states last */
+      std::unordered_map<const double*, int> Offset;
+      int Column = 0;
+      for (double* const State : FactorStates)
+      {
+        if (IsNewest.count(State) == 0 && Offset.count(State) == 0)
+        {
+          Offset.emplace(State, Column);
+          Column += _Graph.ParameterBlockLocalSize(State);
+        }
+      }
+      for (size_t n = 0; n < Cached.size(); n++)
+      {
+        if (IsNewest.count(Cached.at(n)) == 0 && Offset.count(Cached.at(n)) == 0)
+        {
+          Offset.emplace(Cached.at(n), Column);
+          Column += _CovarianceSizes.at(n);
+        }
+      }
+      const int MarginalSize = Column;
+      for (size_t n = 0; n < Newest.size(); n++)
+      {
+        Offset.emplace(Newest.at(n), Column);
+        Column += NewestSizes.at(n);
+      }
+
+      /** stack the new factors and the cached prior */
+      Matrix JacobianNew;
+      if (Factors.empty() == false)
+      {
+        this->evaluateJacobian(Factors, FactorStates, JacobianNew);
+      }
+      Matrix Jacobian = Matrix::Zero(JacobianNew.rows() + _CovarianceSqrtInfo.rows(), Column);
+
+      int ColumnNew = 0;
+      for (double* const State : FactorStates)
+      {
+        const int Size = _Graph.ParameterBlockLocalSize(State);
+        Jacobian.block(0, Offset.at(State), JacobianNew.rows(), Size) = JacobianNew.middleCols(ColumnNew, Size);
+        ColumnNew += Size;
+      }
+
+      int ColumnPrior = 0;
+      for (size_t n = 0; n < Cached.size(); n++)
+      {
+        Jacobian.block(JacobianNew.rows(), Offset.at(Cached.at(n)), _CovarianceSqrtInfo.rows(), _CovarianceSizes.at(n))
+          = _CovarianceSqrtInfo.middleCols(ColumnPrior, _CovarianceSizes.at(n));
+        ColumnPrior += _CovarianceSizes.at(n);
+      }
+
+      /** eliminate everything except the newest states */
+      if (MarginalSize > 0)
+      {
+        Vector ResidualMarg;
+        Matrix JacobianMarg;
+        Marginalize(Vector::Zero(Jacobian.rows()), Jacobian, ResidualMarg, JacobianMarg, MarginalSize);
+        Information = JacobianMarg.transpose() * JacobianMarg;
+      }
+      else
+      {
+        Information = Jacobian.transpose() * Jacobian;
+      }
+    }
+
+    /** invert only the small block */
+    Matrix SqrtInfo, SqrtInfoInv;
+    RobustSqrtAndInvSqrt(Information, SqrtInfo, SqrtInfoInv);
+    const Matrix Covariance = SqrtInfoInv * SqrtInfoInv.transpose();
+
+    /** keep the eliminated part for the next epoch */
+    _CovarianceStates = NewestIDs;
+    _CovarianceSizes = NewestSizes;
+    _CovarianceSqrtInfo = SqrtInfo;
+    _CovarianceRevision = _Structure.getRevision();
+
+    /** write to the states, the covariance is lifted from the local to the global space */
+    int Index = 0;
+    for (size_t n = 0; n < Newest.size(); n++)
+    {
+      const int GlobalSize = _Graph.ParameterBlockSize(Newest.at(n));
+      const int LocalSize = NewestSizes.at(n);
+
+      Matrix Lift = Matrix::Identity(GlobalSize, LocalSize);
+      const ceres::LocalParameterization* Parameterization = _Graph.GetParameterization(Newest.at(n));
+      if (Parameterization != nullptr)
+      {
+        Parameterization->ComputeJacobian(Newest.at(n), Lift.data());
+      }
+
+      Eigen::Map<Matrix>(NewestData.at(n)->getDataPointer(DataElement::Covariance), GlobalSize, GlobalSize)
+        = Lift * Covariance.block(Index, Index, LocalSize, LocalSize) * Lift.transpose();
+
+      Index += LocalSize;
+    }
+
+    return true;
+  }
+
   bool FactorGraph::computeCovarianceSigmaPoints(const string Name, const double Timestamp, const int StateNumber)
   {
     switch (_StateData.getElement(Name, Timestamp, StateNumber).getMean().size())
@@ -479,10 +1236,11 @@ namespace libRSF
       _Structure.removeState(State);
 
       /** remove from ceres */
-      _Graph.RemoveParameterBlock(_StateData.getElement(Name, Timestamp, Number).getMeanPointer());
+      this->removeParameterBlock(_StateData.getElement(Name, Timestamp, Number).getMeanPointer());
 
       /** remove from our StateDataSet */
       _StateData.removeElement(Name, Timestamp, Number);
+      this->forgetState(Name, Timestamp);
     }
     else
     {
@@ -502,11 +1260,12 @@ namespace libRSF
         _Structure.removeState(State);
 
         /** remove from ceres */
-        _Graph.RemoveParameterBlock(_StateData.getElement(Name, Timestamp, StateNumber - 1).getMeanPointer());
+        this->removeParameterBlock(_StateData.getElement(Name, Timestamp, StateNumber - 1).getMeanPointer());
 
         /** remove from our StateDataSet */
         _StateData.removeElement(Name, Timestamp, StateNumber - 1);
       }
+      this->forgetState(Name, Timestamp);
     }
     else
     {
@@ -517,23 +1276,52 @@ namespace libRSF
   void FactorGraph::removeStatesOutsideWindow(string Name, double TimeWindow, double CurrentTime)
   {
     const double CutTime = CurrentTime - TimeWindow;
-    double Timestamp;
-    bool TimestampExists;
 
-    /** loop over timestamps */
-    TimestampExists = _StateData.getTimeFirst(Name, Timestamp);
-    if (TimestampExists)
+    StateDataSet::ObjectStream* Stream = _StateData.getStream(Name);
+    if (Stream == nullptr)
     {
-      while ((Timestamp <= CutTime) && TimestampExists)
-      {
-        double TimestampTemp = Timestamp;
-        TimestampExists = _StateData.getTimeNext(Name, Timestamp, Timestamp);
-        removeState(Name, TimestampTemp);
-      }
+      PRINT_ERROR("State Type doesn't exist: ", Name);
+      return;
     }
-    else
+
+    /** remove all old states from the structure and from ceres */
+    const auto End = Stream->upper_bound(CutTime);
+    for (auto It = Stream->begin(); It != End; ++It)
     {
-      PRINT_ERROR("State Type doesn't exist: ", Name);
+      double* const StatePointer = It->second.getMeanPointer();
+      _Structure.removeState(StatePointer);
+      this->removeParameterBlock(StatePointer);
+    }
+
+    /** remove them from our StateDataSet at once */
+    _StateData.removeElementsBeforeOrEqual(Name, CutTime);
+
+    /** remove them from the queue of the sliding window */
+    const auto EndQueue = _StateQueue.upper_bound(Tick(CutTime));
+    for (auto It = _StateQueue.begin(); It != EndQueue;)
+    {
+      std::vector<string> &Names = It->second;
+      Names.erase(std::remove(Names.begin(), Names.end(), Name), Names.end());
+      It = Names.empty() ? _StateQueue.erase(It) : std::next(It);
+    }
+  }
+
+  void FactorGraph::forgetState(const string &Name, const double Timestamp)
+  {
+    if (_StateData.countElement(Name, Timestamp) > 0)
+    {
+      return;
+    }
+
+    const auto It = _StateQueue.find(Tick(Timestamp));
+    if (It != _StateQueue.end())
+    {
+      std::vector<string> &Names = It->second;
+      Names.erase(std::remove(Names.begin(), Names.end(), Name), Names.end());
+      if (Names.empty())
+      {
+        _StateQueue.erase(It);
+      }
     }
   }
 
@@ -547,20 +1335,20 @@ namespace libRSF
 
   void FactorGraph::removeFactor(const FactorType CurrentFactorType, const double Timestamp)
   {
-    if (_Structure.checkFactor(CurrentFactorType, Timestamp))
+    /** numbers are stable, so factor 0 might be removed already while others remain */
+    if (_Structure.countFactor(CurrentFactorType, Timestamp) > 0)
     {
-      /** loop over factors */
-      ceres::ResidualBlockId CeresID;
-      for (int FactorNumber = _Structure.countFactor(CurrentFactorType, Timestamp); FactorNumber > 0; FactorNumber--)
-      {
-        FactorID Factor(CurrentFactorType, Timestamp, FactorNumber - 1);
-        _Structure.getResidualID(Factor, CeresID);
+      /** get all factors at this timestamp */
+      std::vector<ceres::ResidualBlockId> CeresIDs;
+      _Structure.getResidualIDs(CurrentFactorType, Timestamp, CeresIDs);
 
+      for (const ceres::ResidualBlockId CeresID : CeresIDs)
+      {
         /** remove factor in ceres */
         _Graph.RemoveResidualBlock(CeresID);
 
         /** remove factor in libRSF */
-        _Structure.removeFactor(Factor);
+        _Structure.removeFactor(CeresID);
       }
     }
     else
@@ -571,25 +1359,17 @@ namespace libRSF
 
   void FactorGraph::removeFactorsOutsideWindow(const FactorType CurrentFactorType, const double TimeWindow, const double CurrentTime)
   {
-    /** find start of the existing factors */
-    double FirstTime;
-    _Structure.getTimeFirst(CurrentFactorType, FirstTime);
-
     /** calculate cut-off time */
     const double TimeWindowEnd = roundToTick(CurrentTime - TimeWindow);
 
-    /** remove factors one by one */
-    if (TimeWindowEnd >= FirstTime)
-    {
-      /** get relevant Timestamps */
-      std::vector<double> Timestamps;
-      _Structure.getTimesBelow(CurrentFactorType, TimeWindowEnd, Timestamps);
+    /** remove all old factors from the structure at once */
+    std::vector<ceres::ResidualBlockId> CeresIDs;
+    _Structure.removeFactorsBeforeOrEqual(CurrentFactorType, TimeWindowEnd, CeresIDs);
 
-      /** remove all */
-      for (const double &Time : Timestamps)
-      {
-        this->removeFactor(CurrentFactorType, Time);
-      }
+    /** remove them in ceres */
+    for (const ceres::ResidualBlockId CeresID : CeresIDs)
+    {
+      _Graph.RemoveResidualBlock(CeresID);
     }
   }
 
@@ -603,6 +1383,75 @@ namespace libRSF
     }
   }
 
+  void FactorGraph::slideWindow(const double CurrentTime, const double TimeWindow, const WindowPolicy Policy, const double Inflation)
+  {
+    Timer WindowTimer;
+
+    /** calculate cut-off time */
+    const double CutTime = roundToTick(CurrentTime - TimeWindow);
+    const auto End = _StateQueue.upper_bound(Tick(CutTime));
+
+    if (Policy == WindowPolicy::Marginalize)
+    {
+      /** collect expired states in temporal order */
+      std::vector<StateID> States;
+      for (auto It = _StateQueue.begin(); It != End; ++It)
+      {
+        for (const string &Name : It->second)
+        {
+          const int Numbers = _StateData.countElement(Name, It->first);
+          for (int n = 0; n < Numbers; n++)
+          {
+            States.emplace_back(StateID(Name, It->first, n));
+          }
+        }
+      }
+      _StateQueue.erase(_StateQueue.begin(), End);
+
+      /** the connected factors are replaced by a marginal prior */
+      if (States.empty() == false)
+      {
+        this->marginalizeStates(States, Inflation);
+      }
+    }
+    else
+    {
+      /** remove expired factors first, so they are not touched again by the removal of their states */
+      std::vector<ceres::ResidualBlockId> CeresIDs;
+      _Structure.removeAllFactorsBeforeOrEqual(CutTime, CeresIDs);
+      for (const ceres::ResidualBlockId CeresID : CeresIDs)
+      {
+        _Graph.RemoveResidualBlock(CeresID);
+      }
+
+      /** remove expired states from the structure and from ceres */
+      std::set<string> Names;
+      for (auto It = _StateQueue.begin(); It != End; ++It)
+      {
+        for (const string &Name : It->second)
+        {
+          const int Numbers = _StateData.countElement(Name, It->first);
+          for (int n = 0; n < Numbers; n++)
+          {
+            double* const StatePointer = _StateData.getElement(Name, It->first, n).getMeanPointer();
+            _Structure.removeState(StatePointer);
+            this->removeParameterBlock(StatePointer);
+          }
+          Names.insert(Name);
+        }
+      }
+      _StateQueue.erase(_StateQueue.begin(), End);
+
+      /** remove them from our StateDataSet at once */
+      for (const string &Name : Names)
+      {
+        _StateData.removeElementsBeforeOrEqual(Name, CutTime);
+      }
+    }
+
+    _WindowDuration += WindowTimer.getSeconds();
+  }
+
   void FactorGraph::setConstantOutsideWindow(string Name, double TimeWindow, double CurrentTime)
   {
     /** find start of the current state */
@@ -683,6 +1532,14 @@ namespace libRSF
     return Duration;
   }
 
+  double FactorGraph::getWindowDurationAndReset()
+  {
+    /** reset window duration before value is returned */
+    const double Duration = _WindowDuration;
+    _WindowDuration = 0.0;
+    return Duration;
+  }
+
   int FactorGraph::getSolverIterationsAndReset()
   {
     /** reset marginalization duration before value is returned */
@@ -700,6 +1557,7 @@ namespace libRSF
     {
       ErrorModel->enable();
     }
+    _Modified = true;
   }
 
   void FactorGraph::disableErrorModel(FactorType CurrentFactorType)
@@ -710,6 +1568,7 @@ namespace libRSF
     {
       ErrorModel->disable();
     }
+    _Modified = true;
   }
 
   void FactorGraph::enableErrorModels()
@@ -756,26 +1615,19 @@ namespace libRSF
       return;
     }
 
-    /** check IDs */
+#ifndef NDEBUG
+    /** check IDs against the problem (only in debug mode) */
     std::vector<ceres::ResidualBlockId> IDsCeres;
-    std::vector<bool> Existence;
     _Graph.GetResidualBlocks(&IDsCeres);
-    for (auto const &ID1 : IDs)
+    const std::unordered_set<ceres::ResidualBlockId> IDSetCeres(IDsCeres.begin(), IDsCeres.end());
+    for (auto const &ID : IDs)
     {
-      bool Exists = false;
-      for (auto const &ID2 : IDsCeres)
-      {
-        if (ID1 == ID2)
-        {
-          Exists = true;
-        }
-      }
-      Existence.push_back(Exists);
-      if (Exists == false)
+      if (IDSetCeres.count(ID) == 0)
       {
         PRINT_ERROR("Found missing ID");
       }
     }
+#endif // NDEBUG
 
     /** configure evaluation */
     ceres::Problem::EvaluateOptions Options;
@@ -792,29 +1644,30 @@ namespace libRSF
     /** re-enable error model */
     enableErrorModel(CurrentFactorType);
 
-    /** create factor ID */
-    double TimeFirst;
-    _Structure.getTimeFirst(CurrentFactorType, TimeFirst);
-    FactorID FirstID(CurrentFactorType, TimeFirst, 0);
+    /** all factors of one type have the same dimensions */
+    FactorGraphStructure::FactorInfo FirstInfo;
+    _Structure.getFactorInfo(IDs.front(), FirstInfo);
 
     /** remove unused dimensions */
-    int InputSize, OutputSize;
-    _Structure.getErrorInputSize(FirstID, InputSize);
-    _Structure.getErrorOutputSize(FirstID, OutputSize);
+    const int InputSize = FirstInfo.ErrorInputSize;
+    const int OutputSize = FirstInfo.ErrorOutputSize;
 
-    for (int n = ErrorData.size() - 1; n > 0; n -= OutputSize)
+    /** compact in place, so the capacity of the given vector is kept for the next call */
+    if (InputSize < OutputSize)
     {
-      for (int m = 0 ; m < (OutputSize - InputSize); m++)
+      const int FactorNumber = ErrorData.size() / OutputSize;
+      for (int n = 0; n < FactorNumber; n++)
       {
-        ErrorData.erase(ErrorData.begin() + n - m);
+        std::copy_n(ErrorData.begin() + n * OutputSize, InputSize, ErrorData.begin() + n * InputSize);
       }
+      ErrorData.resize(FactorNumber * InputSize);
     }
   }
 
   void FactorGraph::computeUnweightedErrorMatrix(const FactorType CurrentFactorType, Matrix &ErrorMatrix)
   {
-    /** get the data */
-    std::vector<double> ErrorVector;
+    /** get the data (the buffer is reused across calls) */
+    std::vector<double> &ErrorVector = _ErrorBuffer;
     this->computeUnweightedError(CurrentFactorType, ErrorVector);
 
     /** check for empty vector */
@@ -838,8 +1691,8 @@ namespace libRSF
 
   void FactorGraph::computeUnweightedError(const FactorType CurrentFactorType, const string &Name, StateDataSet &ErrorData)
   {
-    /** get the data */
-    std::vector<double> ErrorVector;
+    /** get the data (the buffer is reused across calls) */
+    std::vector<double> &ErrorVector = _ErrorBuffer;
     this->computeUnweightedError(CurrentFactorType, ErrorVector);
 
     /** check for empty vector */
@@ -932,7 +1785,11 @@ namespace libRSF
     /** get internal ceres ID */
     ceres::ResidualBlockId CeresID;
     FactorID OurID(CurrentFactorType, Time, Number);
-    _Structure.getResidualID(OurID, CeresID);
+    if (_Structure.getResidualID(OurID, CeresID) == false)
+    {
+      PRINT_ERROR("Factor was removed: ", CurrentFactorType, " ", Time, " ", Number);
+      return;
+    }
 
     std::vector<ceres::ResidualBlockId> CeresIDs;
     CeresIDs.push_back(CeresID);
@@ -947,7 +1804,7 @@ namespace libRSF
     disableErrorModel(CurrentFactorType);
 
     /** compute error */
-    std::vector<double> ErrorData;
+    std::vector<double> &ErrorData = _ErrorBuffer;
     _Graph.Evaluate(Options, nullptr, &ErrorData, nullptr, nullptr);
 
     /** re-enable error model again */
@@ -22,6 +22,9 @@
 
 #include "FactorGraphStructure.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace libRSF
 {
   FactorGraphStructure::FactorGraphStructure(ceres::Problem *GraphPointer, StateDataSet * Data): _Data(Data), _Graph(GraphPointer)
@@ -35,11 +38,12 @@ namespace libRSF
                                               std::vector<StateID> &StateIDs,
                                               std::vector<DataType> &StateTypes) const
   {
-    /** sets to store unique values */
-    std::set<double*> BaseStatePointers;
-    std::set<ceres::ResidualBlockId> ConnectedFactorsIDs;
+    /** sets to check for unique values */
+    std::unordered_set<double*> BaseStatePointers;
+    std::unordered_set<ceres::ResidualBlockId> ConnectedFactorsIDs;
 
     /** get all connected factors */
+    std::vector<ceres::ResidualBlockId> Factors;
     for (double* const State : BaseStates)
     {
       /** safety check */
@@ -50,57 +54,55 @@ namespace libRSF
       }
 
       /** store pointer for check */
-      if(BaseStatePointers.count(State) != 0)
+      if(BaseStatePointers.emplace(State).second == false)
       {
         PRINT_ERROR("Duplicated pointer for marginalized states!");
         return;
       }
-      BaseStatePointers.emplace(State);
 
-      /** query residual IDs */
-      std::vector<ceres::ResidualBlockId> Factors;
+      /** query residual IDs and add only new factors */
       _Graph->GetResidualBlocksForParameterBlock(State, &Factors);
       for(ceres::ResidualBlockId Factor : Factors)
       {
-        /** add only new factors */
-        if(ConnectedFactorsIDs.count(Factor) == 0)
+        if(ConnectedFactorsIDs.emplace(Factor).second)
         {
-          ConnectedFactorsIDs.emplace(Factor);
+          ConnectedFactors.emplace_back(Factor);
         }
       }
     }
 
+    /** keep the order independent from the hash */
+    std::sort(ConnectedFactors.begin(), ConnectedFactors.end());
+
     /** get all connected states */
-    std::set<double*> ConnectedStatePointers;
-    for (const ceres::ResidualBlockId Factor : ConnectedFactorsIDs)
+    std::unordered_set<double*> ConnectedStatePointers;
+    std::vector<double*> CurrentStatePointers;
+    const size_t StatesFirst = ConnectedStates.size();
+    for (const ceres::ResidualBlockId Factor : ConnectedFactors)
     {
-      std::vector<double*> CurrentStatePointers;
-
       /** query states that are connected with a certain factor */
       _Graph->GetParameterBlocksForResidualBlock(Factor, &CurrentStatePointers);
 
       /** add only unique states */
       for (double* StatePointer : CurrentStatePointers)
       {
-        if(ConnectedStatePointers.count(StatePointer) == 0 && BaseStatePointers.count(StatePointer) == 0)
+        if(BaseStatePointers.count(StatePointer) == 0 && ConnectedStatePointers.emplace(StatePointer).second)
         {
-          ConnectedStatePointers.emplace(StatePointer);
+          ConnectedStates.emplace_back(StatePointer);
         }
       }
-
-      /** copy from set to vector */
-      ConnectedFactors.emplace_back(Factor);
     }
+    std::sort(ConnectedStates.begin() + StatesFirst, ConnectedStates.end());
 
-    /** copy into vector */
-    for (double* const State : ConnectedStatePointers)
+    /** collect properties */
+    for (size_t n = StatesFirst; n < ConnectedStates.size(); ++n)
     {
-      ConnectedStates.emplace_back(State);
+      double* const State = ConnectedStates.at(n);
       StateDims.emplace_back(_Graph->ParameterBlockSize(State));
       StateDimsLocal.emplace_back(_Graph->ParameterBlockLocalSize(State));
 
       /** find state info */
-      StateInfo Info = _States.at(State);
+      const StateInfo &Info = _States.at(State);
       StateIDs.emplace_back(StateID(Info.Name, Info.Timestamp, Info.Number));
       StateTypes.emplace_back(Info.Type);
     }
@@ -126,19 +128,23 @@ namespace libRSF
     Factors.clear();
     for(const ceres::ResidualBlockId Res: Residuals)
     {
-      FactorID Factor(_Factors.at(Res).Type, _Factors.at(Res).Timestamp, _Factors.at(Res).Number);
-      Factors.push_back(Factor);
+      const FactorInfo &Info = _Factors.at(Res);
+      Factors.emplace_back(Info.Type, Info.Timestamp, Info.Number);
     }
 
   }
 
   void FactorGraphStructure::removeState(const StateID &State)
   {
-    /** get raw pointer*/
-    double* StatePointer = _Data->getElement(State.ID, State.Timestamp, State.Number).getMeanPointer();
+    this->removeState(_Data->getElement(State.ID, State.Timestamp, State.Number).getMeanPointer());
+  }
 
+  void FactorGraphStructure::removeState(double* const StatePointer)
+  {
     /** remove state info */
-    _States.erase(StatePointer);
+    const int Removed = static_cast<int>(_States.erase(StatePointer));
+    _Changes.RemovedStates += Removed;
+    _Revision += Removed;
 
     /** get connected factors */
     std::vector<ceres::ResidualBlockId> Factors;
@@ -151,87 +157,402 @@ namespace libRSF
     }
   }
 
+  void FactorGraphStructure::addStates(const std::vector<StateID> &States,
+                                       const std::vector<double*> &StatePointers,
+                                       const std::vector<DataType> &StateTypes)
+  {
+    _Changes.ConnectedStates.insert(_Changes.ConnectedStates.end(), StatePointers.begin(), StatePointers.end());
+
+    for(int n = 0; n < static_cast<int>(States.size()); n++)
+    {
+      if(_States.count(StatePointers.at(n)) == 0) /**< check if already existing */
+      {
+        StateInfo State;
+        State.Name = States.at(n).ID;
+        State.Timestamp = States.at(n).Timestamp;
+        State.Number = States.at(n).Number;
+        State.Type = StateTypes.at(n);
+
+        _States.emplace(StatePointers.at(n), State);
+        _Changes.AddedStates++;
+        _Revision++;
+      }
+    }
+  }
+
+  int FactorGraphStructure::insertFactor(const FactorType Type, const double Timestamp, const ceres::ResidualBlockId CeresID)
+  {
+    FactorTimeline &Timeline = _FactorList[Type];
+    FactorSlot &Slot = Timeline.Slots[Tick(Timestamp)];
+
+    /** a new slot has to leave the window at some point */
+    if (Slot.Factors.empty())
+    {
+      std::vector<FactorType> &Types = _EvictionQueue[Tick(Timestamp)];
+      if (std::find(Types.begin(), Types.end(), Type) == Types.end())
+      {
+        Types.emplace_back(Type);
+      }
+    }
+
+    Slot.Factors.emplace_back(CeresID);
+    Slot.Count++;
+    Timeline.Count++;
+    _Changes.AddedFactors++;
+    _Revision++;
+
+    return static_cast<int>(Slot.Factors.size()) - 1;
+  }
+
+  void FactorGraphStructure::forgetSlot(const FactorType Type, const Tick Timestamp)
+  {
+    const auto ItQueue = _EvictionQueue.find(Timestamp);
+    if (ItQueue == _EvictionQueue.end())
+    {
+      return;
+    }
+
+    std::vector<FactorType> &Types = ItQueue->second;
+    Types.erase(std::remove(Types.begin(), Types.end(), Type), Types.end());
+    if (Types.empty())
+    {
+      _EvictionQueue.erase(ItQueue);
+    }
+  }
+
+  const FactorGraphStructure::FactorSlot* FactorGraphStructure::findSlot(const FactorType Type, const double Timestamp) const
+  {
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      return nullptr;
+    }
+
+    const auto ItSlot = ItTimeline->second.Slots.find(Tick(Timestamp));
+    if (ItSlot == ItTimeline->second.Slots.end())
+    {
+      return nullptr;
+    }
+
+    return &ItSlot->second;
+  }
+
   void FactorGraphStructure::removeFactor(const ceres::ResidualBlockId Factor)
   {
-    /** clear mapping libRSF --> ceres */
-    FactorInfo Info = _Factors.at(Factor);
-    _FactorList.removeElement(Info.Type, Info.Timestamp, Info.Number);
+    const auto ItFactor = _Factors.find(Factor);
+    if (ItFactor == _Factors.end())
+    {
+      PRINT_ERROR("Factor is not part of the structure!");
+      return;
+    }
+    const FactorInfo &Info = ItFactor->second;
+
+    /** clear mapping libRSF --> ceres, the numbers of the other factors are not touched */
+    const auto ItTimeline = _FactorList.find(Info.Type);
+    FactorTimeline &Timeline = ItTimeline->second;
+    const auto ItSlot = Timeline.Slots.find(Info.Timestamp);
+    ItSlot->second.Factors.at(Info.Number) = nullptr;
+    ItSlot->second.Count--;
+    Timeline.Count--;
+
+    /** erase empty containers */
+    if (ItSlot->second.Count == 0)
+    {
+      this->forgetSlot(Info.Type, ItSlot->first);
+      Timeline.Slots.erase(ItSlot);
+    }
+    if (Timeline.Count == 0)
+    {
+      _FactorList.erase(ItTimeline);
+    }
 
     /** clear mapping ceres --> libRSF */
-    _Factors.erase(Factor);
+    _Factors.erase(ItFactor);
+    _Changes.RemovedFactors++;
+    _Revision++;
+  }
 
-    /** decrement index in factor info to correct the number of the elements above the deleted one*/
-    for (int n = Info.Number; n < _FactorList.countElement(Info.Type, Info.Timestamp); n++)
+  void FactorGraphStructure::removeFactor(const FactorID &Factor)
+  {
+    ceres::ResidualBlockId Residual;
+    if (this->checkFactor(Factor.ID, Factor.Timestamp, Factor.Number))
     {
-      _Factors.at(_FactorList.getElement(Info.Type, Info.Timestamp, n)).Number--;
+      if (this->getResidualID(Factor, Residual))
+      {
+        this->removeFactor(Residual);
+      }
+    }
+    else
+    {
+      PRINT_ERROR("Factor doesn't exist: ", Factor);
     }
   }
 
-  void FactorGraphStructure::removeFactor(const FactorID &Factor)
+  void FactorGraphStructure::removeFactorsBeforeOrEqual(const FactorType Type, const double Timestamp, std::vector<ceres::ResidualBlockId> &Removed)
+  {
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      return;
+    }
+    FactorTimeline &Timeline = ItTimeline->second;
+
+    /** the slots are sorted, so only the front has to be touched */
+    const auto End = Timeline.Slots.upper_bound(Tick(Timestamp));
+    for (auto ItSlot = Timeline.Slots.begin(); ItSlot != End; ++ItSlot)
+    {
+      for (const ceres::ResidualBlockId Factor : ItSlot->second.Factors)
+      {
+        if (Factor != nullptr)
+        {
+          Removed.emplace_back(Factor);
+          _Factors.erase(Factor);
+          _Changes.RemovedFactors++;
+          _Revision++;
+        }
+      }
+      Timeline.Count -= ItSlot->second.Count;
+      this->forgetSlot(Type, ItSlot->first);
+    }
+    Timeline.Slots.erase(Timeline.Slots.begin(), End);
+
+    if (Timeline.Count == 0)
+    {
+      _FactorList.erase(ItTimeline);
+    }
+  }
+
+  void FactorGraphStructure::removeAllFactorsBeforeOrEqual(const double Timestamp, std::vector<ceres::ResidualBlockId> &Removed)
+  {
+    /** the queue is sorted, so only expired slots are visited */
+    const auto End = _EvictionQueue.upper_bound(Tick(Timestamp));
+    for (auto ItQueue = _EvictionQueue.begin(); ItQueue != End; ++ItQueue)
+    {
+      for (const FactorType Type : ItQueue->second)
+      {
+        /** the slot may have been removed already by other functions */
+        const auto ItTimeline = _FactorList.find(Type);
+        if (ItTimeline == _FactorList.end())
+        {
+          continue;
+        }
+        FactorTimeline &Timeline = ItTimeline->second;
+
+        const auto ItSlot = Timeline.Slots.find(ItQueue->first);
+        if (ItSlot == Timeline.Slots.end())
+        {
+          continue;
+        }
+
+        for (const ceres::ResidualBlockId Factor : ItSlot->second.Factors)
+        {
+          if (Factor != nullptr)
+          {
+            Removed.emplace_back(Factor);
+            _Factors.erase(Factor);
+            _Changes.RemovedFactors++;
+            _Revision++;
+          }
+        }
+        Timeline.Count -= ItSlot->second.Count;
+        Timeline.Slots.erase(ItSlot);
+
+        if (Timeline.Count == 0)
+        {
+          _FactorList.erase(ItTimeline);
+        }
+      }
+    }
+    _EvictionQueue.erase(_EvictionQueue.begin(), End);
+  }
+
+  const FactorGraphStructure::Changes& FactorGraphStructure::getChanges() const
   {
-    this->removeFactor(_FactorList.getElement(Factor.ID, Factor.Timestamp, Factor.Number));
+    return _Changes;
   }
 
-  void FactorGraphStructure::getResidualID(const FactorID &Factor, ceres::ResidualBlockId &Residual) const
+  int64_t FactorGraphStructure::getRevision() const
   {
-    _FactorList.getElement(Factor.ID, Factor.Timestamp, Factor.Number, Residual);
+    return _Revision;
   }
 
-  void FactorGraphStructure::getErrorModel(const FactorID &Factor, ErrorModelBase* &ErroModel) const
+  void FactorGraphStructure::resetChanges()
   {
+    _Changes.AddedStates = 0;
+    _Changes.RemovedStates = 0;
+    _Changes.AddedFactors = 0;
+    _Changes.RemovedFactors = 0;
+    _Changes.ConnectedStates.clear();
+  }
+
+  bool FactorGraphStructure::getResidualID(const FactorID &Factor, ceres::ResidualBlockId &Residual) const
+  {
+    Residual = nullptr;
+
+    /** removed factors leave a hole with nullptr */
+    const FactorSlot* Slot = this->findSlot(Factor.ID, Factor.Timestamp);
+    if (Slot != nullptr && Factor.Number >= 0 && Factor.Number < static_cast<int>(Slot->Factors.size()))
+    {
+      Residual = Slot->Factors[Factor.Number];
+    }
+
+    return Residual != nullptr;
+  }
+
+  bool FactorGraphStructure::getErrorModel(const FactorID &Factor, ErrorModelBase* &ErroModel) const
+  {
+    ErroModel = nullptr;
+
     ceres::ResidualBlockId ID;
-    this->getResidualID(Factor, ID);
+    if (this->getResidualID(Factor, ID) == false)
+    {
+      PRINT_ERROR("Factor doesn't exist: ", Factor);
+      return false;
+    }
+
     ErroModel = _Factors.at(ID).ErrorModel;
+    return true;
   }
 
-  void FactorGraphStructure::getErrorInputSize(const FactorID &Factor, int &ResidualSize) const
+  bool FactorGraphStructure::getErrorInputSize(const FactorID &Factor, int &ResidualSize) const
   {
+    ResidualSize = 0;
+
     ceres::ResidualBlockId ID;
-    this->getResidualID(Factor, ID);
+    if (this->getResidualID(Factor, ID) == false)
+    {
+      PRINT_ERROR("Factor doesn't exist: ", Factor);
+      return false;
+    }
+
     ResidualSize = _Factors.at(ID).ErrorInputSize;
+    return true;
   }
 
-  void FactorGraphStructure::getErrorOutputSize(const FactorID &Factor, int &ResidualSize) const
+  bool FactorGraphStructure::getErrorOutputSize(const FactorID &Factor, int &ResidualSize) const
   {
+    ResidualSize = 0;
+
     ceres::ResidualBlockId ID;
-    this->getResidualID(Factor, ID);
+    if (this->getResidualID(Factor, ID) == false)
+    {
+      PRINT_ERROR("Factor doesn't exist: ", Factor);
+      return false;
+    }
+
     ResidualSize = _Factors.at(ID).ErrorOutputSize;
+    return true;
+  }
+
+  bool FactorGraphStructure::getFactorInfo(const ceres::ResidualBlockId Factor, FactorInfo &Info) const
+  {
+    const auto It = _Factors.find(Factor);
+    if (It == _Factors.end())
+    {
+      return false;
+    }
+    Info = It->second;
+    return true;
   }
 
   void FactorGraphStructure::getFactorIDs(const FactorType Type, std::vector<FactorID> &Factors) const
   {
-    _FactorList.getUniqueIDs(Type, Factors);
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      PRINT_ERROR("There is no ID: ", Type);
+      return;
+    }
+
+    Factors.reserve(Factors.size() + ItTimeline->second.Count);
+    for (const auto &Slot : ItTimeline->second.Slots)
+    {
+      for (int n = 0; n < static_cast<int>(Slot.second.Factors.size()); ++n)
+      {
+        if (Slot.second.Factors[n] != nullptr)
+        {
+          Factors.emplace_back(Type, Slot.first, n);
+        }
+      }
+    }
   }
 
   void FactorGraphStructure::getErrorModels(const FactorType Type, std::vector<ErrorModelBase*> &Models) const
   {
-    /**get IDs */
-    std::vector<FactorID> Factors;
-    this->getFactorIDs(Type, Factors);
+    /** get IDs */
+    std::vector<ceres::ResidualBlockId> Factors;
+    this->getResidualIDs(Type, Factors);
 
     /** translate to models */
-    for(auto const &Factor: Factors)
+    Models.reserve(Models.size() + Factors.size());
+    for(const ceres::ResidualBlockId Factor: Factors)
     {
-      ErrorModelBase* Model;
-      this->getErrorModel(Factor, Model);
-      Models.push_back(Model);
+      Models.push_back(_Factors.at(Factor).ErrorModel);
     }
   }
 
   void FactorGraphStructure::getResidualIDs(const FactorType Type, std::vector<ceres::ResidualBlockId> &Blocks) const
   {
-    Blocks = _FactorList.getElementsOfID(Type);
+    Blocks.clear();
+
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      PRINT_WARNING("Returned empty vector!");
+      return;
+    }
+
+    Blocks.reserve(ItTimeline->second.Count);
+    for (const auto &Slot : ItTimeline->second.Slots)
+    {
+      for (const ceres::ResidualBlockId Factor : Slot.second.Factors)
+      {
+        if (Factor != nullptr)
+        {
+          Blocks.emplace_back(Factor);
+        }
+      }
+    }
+  }
+
+  void FactorGraphStructure::getResidualIDs(const FactorType Type, const double Timestamp, std::vector<ceres::ResidualBlockId> &Blocks) const
+  {
+    Blocks.clear();
+
+    const FactorSlot* Slot = this->findSlot(Type, Timestamp);
+    if (Slot != nullptr)
+    {
+      for (const ceres::ResidualBlockId Factor : Slot->Factors)
+      {
+        if (Factor != nullptr)
+        {
+          Blocks.emplace_back(Factor);
+        }
+      }
+    }
   }
 
   void FactorGraphStructure::getTimesBetween(const FactorType Type, const double StartTime, const double EndTime, std::vector<double> &Times) const
   {
-    _FactorList.getTimesBetween(Type, StartTime, EndTime, Times);
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      PRINT_ERROR("There is no ID: ", Type);
+      return;
+    }
+
+    const auto &Slots = ItTimeline->second.Slots;
+    const auto End = Slots.upper_bound(Tick(EndTime));
+    for (auto It = Slots.lower_bound(Tick(StartTime)); It != End; ++It)
+    {
+      Times.push_back(It->first);
+    }
   }
 
   void FactorGraphStructure::getTimesBelow(const FactorType Type, const double EndTime, std::vector<double> &Times) const
   {
     double StartTime;
-    if(_FactorList.getTimeFirst(Type, StartTime))
+    if(this->getTimeFirst(Type, StartTime))
     {
       if(StartTime <= EndTime)
       {
@@ -246,36 +567,60 @@ namespace libRSF
 
   bool FactorGraphStructure::getTimeFirst(const FactorType Type, double& FirstTime) const
   {
-    return _FactorList.getTimeFirst(Type, FirstTime);
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      return false;
+    }
+    FirstTime = ItTimeline->second.Slots.begin()->first;
+    return true;
   }
 
   bool FactorGraphStructure::getTimeLast(const FactorType Type, double& LastTime) const
   {
-    return _FactorList.getTimeLast(Type, LastTime);
+    const auto ItTimeline = _FactorList.find(Type);
+    if (ItTimeline == _FactorList.end())
+    {
+      return false;
+    }
+    LastTime = std::prev(ItTimeline->second.Slots.end())->first;
+    return true;
   }
 
   void FactorGraphStructure::getFactorTypes(std::vector<FactorType> &Factors) const
   {
-    Factors = _FactorList.getKeysAll();
+    Factors.clear();
+    for (const auto &Timeline : _FactorList)
+    {
+      Factors.push_back(Timeline.first);
+    }
+    if(Factors.empty())
+    {
+      PRINT_WARNING("Returned empty vector!");
+    }
   }
 
   int FactorGraphStructure::countFactor(const FactorType Type, const double Timestamp) const
   {
-    return _FactorList.countElement(Type, Timestamp);
+    const FactorSlot* Slot = this->findSlot(Type, Timestamp);
+    return (Slot == nullptr) ? 0 : Slot->Count;
   }
 
   int FactorGraphStructure::countFactorType(const FactorType Type) const
   {
-    return _FactorList.countElements(Type);
+    const auto ItTimeline = _FactorList.find(Type);
+    return (ItTimeline == _FactorList.end()) ? 0 : ItTimeline->second.Count;
   }
 
   bool FactorGraphStructure::checkFactor(const FactorType Type, const double Timestamp, const double Number) const
   {
-    return _FactorList.checkElement(Type, Timestamp, Number);
+    const FactorSlot* Slot = this->findSlot(Type, Timestamp);
+    const int Index = static_cast<int>(Number);
+    return Slot != nullptr && Index >= 0 && Index < static_cast<int>(Slot->Factors.size()) && Slot->Factors[Index] != nullptr;
   }
 
   bool FactorGraphStructure::checkFactor(const FactorType Type) const
   {
-    return _FactorList.checkID(Type);
+    return _FactorList.count(Type) > 0;
   }
 }
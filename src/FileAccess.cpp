@@ -22,40 +22,510 @@
 
 #include "FileAccess.h"
 
+#include <charconv>
+#include <cstring>
+#include <queue>
+#include <functional>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace libRSF
 {
+  /** read-only memory mapping of a whole file */
+  class MappedFile
+  {
+    public:
+      explicit MappedFile(const string &Filename)
+      {
+        const int FileDescriptor = open(Filename.c_str(), O_RDONLY);
+        if (FileDescriptor < 0)
+        {
+          return;
+        }
+
+        struct stat FileStatus;
+        if (fstat(FileDescriptor, &FileStatus) == 0 && FileStatus.st_size > 0)
+        {
+          _Size = static_cast<size_t>(FileStatus.st_size);
+          _Mapping = mmap(nullptr, _Size, PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+
+          if (_Mapping == MAP_FAILED)
+          {
+            _Mapping = nullptr;
+            _Size = 0;
+          }
+          else
+          {
+            madvise(_Mapping, _Size, MADV_SEQUENTIAL);
+          }
+        }
+        close(FileDescriptor);
+      }
+
+      ~MappedFile()
+      {
+        if (_Mapping != nullptr)
+        {
+          munmap(_Mapping, _Size);
+        }
+      }
+
+      MappedFile(const MappedFile&) = delete;
+      MappedFile& operator = (const MappedFile&) = delete;
+
+      bool isOpen() const
+      {
+        return _Mapping != nullptr;
+      }
+
+      const char* begin() const
+      {
+        return static_cast<const char*>(_Mapping);
+      }
+
+      const char* end() const
+      {
+        return static_cast<const char*>(_Mapping) + _Size;
+      }
+
+      size_t size() const
+      {
+        return _Size;
+      }
+
+    private:
+      void* _Mapping = nullptr;
+      size_t _Size = 0;
+  };
+
+  /** call Handle for each measurement between Current and End, stops at the first empty line or if Handle returns false */
+  template <typename HandleType>
+  static const char* ParseLines(const char* Current, const char* const End, HandleType Handle)
+  {
+    while (Current < End)
+    {
+      /** find the end of the current line */
+      const char* LineEnd = static_cast<const char*>(std::memchr(Current, '\n', End - Current));
+      if (LineEnd == nullptr)
+      {
+        LineEnd = End;
+      }
+
+      std::string_view Line(Current, LineEnd - Current);
+      if (!Line.empty() && Line.back() == '\r')
+      {
+        Line.remove_suffix(1);
+      }
+
+      /** an empty line marks the end of the data */
+      if (Line.empty())
+      {
+        return Current;
+      }
+
+      /** parse directly from the mapped memory */
+      const Data Measurement(Line);
+      if (Measurement.checkElement(DataElement::Timestamp) && Handle(Measurement) == false)
+      {
+        return LineEnd;
+      }
+
+      Current = std::min(LineEnd + 1, End);
+    }
+    return End;
+  }
 
   void ReadDataFromFile(const string Filename,
                         SensorDataSet& SensorData)
   {
-    string Buffer;
-    std::ifstream File;
+    const MappedFile File(Filename);
+    if (!File.isOpen())
+    {
+      PRINT_ERROR("Could not open file: ", Filename);
+      return;
+    }
 
-    File.open(Filename);
-    std::getline(File, Buffer);
+    ParseLines(File.begin(), File.end(), [&SensorData](const Data &Measurement)
+    {
+      SensorData.addElement(Measurement.getType(), Measurement.getTimestamp(), Measurement);
+      return true;
+    });
+  }
 
-    while(Buffer.length() > 0)
+  void ReadDataFromFile(const string Filename,
+                        const std::function<bool(const Data&)> &Handle)
+  {
+    const MappedFile File(Filename);
+    if (!File.isOpen())
     {
-      SensorData.addElement(Data(Buffer));
-      std::getline(File, Buffer);
+      PRINT_ERROR("Could not open file: ", Filename);
+      return;
     }
 
-    File.close();
+    /** the handle can stop the reader by returning false */
+    ParseLines(File.begin(), File.end(), Handle);
+  }
+
+  /** parse only the timestamp, which follows the type name */
+  static bool ParseTimestamp(std::string_view Line, double &Timestamp)
+  {
+    const char* Current = Line.data();
+    const char* const End = Line.data() + Line.size();
+
+    auto IsSpace = [](const char Character)
+    {
+      return Character == ' ' || Character == '\t';
+    };
+
+    while (Current < End && IsSpace(*Current))
+    {
+      Current++;
+    }
+    while (Current < End && !IsSpace(*Current))
+    {
+      Current++;
+    }
+    while (Current < End && (IsSpace(*Current) || *Current == '+'))
+    {
+      Current++;
+    }
+
+    return std::from_chars(Current, End, Timestamp).ec == std::errc();
   }
 
+  /** returns the line without line break and moves Current to the next line */
+  static std::string_view NextLine(const char* &Current, const char* const End)
+  {
+    const char* LineEnd = static_cast<const char*>(std::memchr(Current, '\n', End - Current));
+    if (LineEnd == nullptr)
+    {
+      LineEnd = End;
+    }
+
+    std::string_view Line(Current, LineEnd - Current);
+    if (!Line.empty() && Line.back() == '\r')
+    {
+      Line.remove_suffix(1);
+    }
+
+    Current = std::min(LineEnd + 1, End);
+    return Line;
+  }
+
+  void ReadDataFromFileInTimeOrder(const string Filename,
+                                   const std::function<bool(const Data&)> &Handle)
+  {
+    const MappedFile File(Filename);
+    if (!File.isOpen())
+    {
+      PRINT_ERROR("Could not open file: ", Filename);
+      return;
+    }
+
+    /** a run is a part of the file with non-decreasing timestamps, e.g. the block of one type */
+    struct Run
+    {
+      const char* Current;
+      const char* End;
+      Tick Timestamp;
+    };
+    std::vector<Run> Runs;
+
+    /** first pass: find the runs by parsing only the timestamps */
+    const char* Current = File.begin();
+    Tick Last;
+    while (Current < File.end())
+    {
+      const char* const LineBegin = Current;
+      const std::string_view Line = NextLine(Current, File.end());
+
+      /** an empty line marks the end of the data */
+      if (Line.empty())
+      {
+        Current = LineBegin;
+        break;
+      }
+
+      double Timestamp;
+      if (ParseTimestamp(Line, Timestamp))
+      {
+        if (Runs.empty() || Tick(Timestamp) < Last)
+        {
+          if (!Runs.empty())
+          {
+            Runs.back().End = LineBegin;
+          }
+          Runs.push_back({LineBegin, nullptr, Tick(Timestamp)});
+        }
+        Last = Tick(Timestamp);
+      }
+    }
+    if (Runs.empty())
+    {
+      return;
+    }
+    Runs.back().End = Current;
+
+    /** second pass: merge the runs, equal timestamps keep the order of the file */
+    auto Later = [&Runs](const int A, const int B)
+    {
+      if (Runs[A].Timestamp == Runs[B].Timestamp)
+      {
+        return A > B;
+      }
+      return Runs[B].Timestamp < Runs[A].Timestamp;
+    };
+    std::priority_queue<int, std::vector<int>, decltype(Later)> Heads(Later);
+    for (int nRun = 0; nRun < static_cast<int>(Runs.size()); nRun++)
+    {
+      Heads.push(nRun);
+    }
+
+    while (!Heads.empty())
+    {
+      const int nRun = Heads.top();
+      Heads.pop();
+      Run &Head = Runs[nRun];
+
+      /** parse and pass the oldest measurement */
+      const Data Measurement(NextLine(Head.Current, Head.End));
+      if (Measurement.checkElement(DataElement::Timestamp) && Handle(Measurement) == false)
+      {
+        return;
+      }
+
+      /** find the next line with a timestamp in this run */
+      while (Head.Current < Head.End)
+      {
+        const char* const LineBegin = Head.Current;
+        double Timestamp;
+        if (ParseTimestamp(NextLine(Head.Current, Head.End), Timestamp))
+        {
+          Head.Current = LineBegin;
+          Head.Timestamp = Tick(Timestamp);
+          Heads.push(nRun);
+          break;
+        }
+      }
+    }
+  }
+
+  /** measurements of one chunk, sorted by time for each type */
+  typedef std::map<DataType, std::vector<Data>> SortedRuns;
+
+  static void SortRuns(SortedRuns &Runs)
+  {
+    auto Earlier = [](const Data &A, const Data &B)
+    {
+      return Tick(A.getTimestamp()) < Tick(B.getTimestamp());
+    };
+
+    for (auto &Run : Runs)
+    {
+      /** files are usually ordered already, the stable sort keeps the order of equal timestamps */
+      if (!std::is_sorted(Run.second.begin(), Run.second.end(), Earlier))
+      {
+        std::stable_sort(Run.second.begin(), Run.second.end(), Earlier);
+      }
+    }
+  }
+
+  static void MergeRuns(std::vector<SortedRuns>::const_iterator FirstChunk,
+                        std::vector<SortedRuns>::const_iterator LastChunk,
+                        SensorDataSet &SensorData)
+  {
+    /** collect the runs of each type in order of the file */
+    std::map<DataType, std::vector<const std::vector<Data>*>> RunsOfType;
+    for (auto Chunk = FirstChunk; Chunk != LastChunk; ++Chunk)
+    {
+      for (const auto &Run : *Chunk)
+      {
+        RunsOfType[Run.first].push_back(&Run.second);
+      }
+    }
+
+    for (const auto &Runs : RunsOfType)
+    {
+      /** k-way merge with a min-heap of (time, run), equal timestamps are taken from the earlier chunk first */
+      typedef std::pair<Tick, int> Head;
+      std::priority_queue<Head, std::vector<Head>, std::greater<Head>> Heads;
+      std::vector<size_t> Position(Runs.second.size(), 0);
+      for (int nRun = 0; nRun < static_cast<int>(Runs.second.size()); nRun++)
+      {
+        if (!Runs.second.at(nRun)->empty())
+        {
+          Heads.emplace(Tick(Runs.second.at(nRun)->front().getTimestamp()), nRun);
+        }
+      }
+
+      while (!Heads.empty())
+      {
+        const int nRun = Heads.top().second;
+        Heads.pop();
+
+        /** the output is sorted, so each element is appended without searching the stream */
+        const std::vector<Data> &Run = *Runs.second.at(nRun);
+        const Data &Measurement = Run.at(Position.at(nRun)++);
+        SensorData.appendElement(Runs.first, Measurement.getTimestamp(), Measurement);
+
+        if (Position.at(nRun) < Run.size())
+        {
+          Heads.emplace(Tick(Run.at(Position.at(nRun)).getTimestamp()), nRun);
+        }
+      }
+    }
+  }
+
+  static void ReadDataParallel(const std::vector<string> &Filenames,
+                               const std::vector<SensorDataSet*> &SensorData,
+                               const int ThreadNumber,
+                               const size_t MinChunkSize)
+  {
+    const int Threads = (ThreadNumber > 0) ? ThreadNumber : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    /** a chunk is a line-aligned part of one file */
+    struct Chunk
+    {
+      int File;
+      const char* Begin;
+      const char* End;
+    };
+
+    std::vector<std::unique_ptr<MappedFile>> Files;
+    std::vector<Chunk> Chunks;
+    std::vector<int> FirstChunk;
+    for (int nFile = 0; nFile < static_cast<int>(Filenames.size()); nFile++)
+    {
+      Files.emplace_back(std::make_unique<MappedFile>(Filenames.at(nFile)));
+      FirstChunk.push_back(static_cast<int>(Chunks.size()));
+
+      if (!Files.back()->isOpen())
+      {
+        PRINT_ERROR("Could not open file: ", Filenames.at(nFile));
+        continue;
+      }
+
+      /** an empty line marks the end of the data */
+      const std::string_view Content(Files.back()->begin(), Files.back()->size());
+      size_t DataEnd = std::min(Content.find("\n\n"), Content.find("\n\r\n"));
+      DataEnd = (DataEnd == std::string_view::npos) ? Content.size() : DataEnd + 1;
+
+      /** split into line-aligned chunks */
+      const size_t ChunkSize = std::max<size_t>(std::max<size_t>(MinChunkSize, 1), DataEnd / (2 * Threads) + 1);
+      const char* const End = Files.back()->begin() + DataEnd;
+      const char* Current = Files.back()->begin();
+      while (Current < End)
+      {
+        const char* ChunkEnd = Current + std::min(ChunkSize, static_cast<size_t>(End - Current));
+        const char* LineEnd = static_cast<const char*>(std::memchr(ChunkEnd, '\n', End - ChunkEnd));
+        ChunkEnd = (LineEnd == nullptr) ? End : LineEnd + 1;
+
+        Chunks.push_back({nFile, Current, ChunkEnd});
+        Current = ChunkEnd;
+      }
+    }
+    FirstChunk.push_back(static_cast<int>(Chunks.size()));
+
+    /** parse chunks on a pool of worker threads */
+    std::vector<SortedRuns> Results(Chunks.size());
+    std::atomic<int> NextChunk(0);
+    auto Worker = [&Chunks, &Results, &NextChunk]()
+    {
+      for (int nChunk = NextChunk++; nChunk < static_cast<int>(Chunks.size()); nChunk = NextChunk++)
+      {
+        SortedRuns &Runs = Results.at(nChunk);
+        ParseLines(Chunks.at(nChunk).Begin, Chunks.at(nChunk).End, [&Runs](const Data &Measurement)
+        {
+          Runs[Measurement.getType()].push_back(Measurement);
+          return true;
+        });
+        SortRuns(Runs);
+      }
+    };
+
+    std::vector<std::thread> Pool;
+    for (int nThread = 1; nThread < std::min(Threads, static_cast<int>(Chunks.size())); nThread++)
+    {
+      Pool.emplace_back(Worker);
+    }
+    Worker();
+    for (std::thread &Thread : Pool)
+    {
+      Thread.join();
+    }
+
+    /** merge the sorted runs of each file */
+    for (int nFile = 0; nFile < static_cast<int>(Filenames.size()); nFile++)
+    {
+      MergeRuns(Results.cbegin() + FirstChunk.at(nFile),
+                Results.cbegin() + FirstChunk.at(nFile + 1),
+                *SensorData.at(nFile));
+    }
+  }
+
+  void ReadDataFromFileParallel(const string Filename,
+                                SensorDataSet& SensorData,
+                                const int ThreadNumber,
+                                const size_t MinChunkSize)
+  {
+    ReadDataParallel({Filename}, {&SensorData}, ThreadNumber, MinChunkSize);
+  }
+
+  void ReadDataFromFilesParallel(const std::vector<string> &Filenames,
+                                 std::vector<SensorDataSet>& SensorData,
+                                 const int ThreadNumber,
+                                 const size_t MinChunkSize)
+  {
+    SensorData.resize(Filenames.size());
+
+    std::vector<SensorDataSet*> SensorDataPointers;
+    for (SensorDataSet &Set : SensorData)
+    {
+      SensorDataPointers.push_back(&Set);
+    }
+
+    ReadDataParallel(Filenames, SensorDataPointers, ThreadNumber, MinChunkSize);
+  }
+
+  /** output is collected in a buffer and written in large blocks */
+  static const size_t WriteBufferSize = 1 << 20;
+
   void WriteDataToFile(const string Filename,
                        const string DataName,
                        const StateDataSet& SensorData,
                        const bool Append)
   {
-    double Timestamp;
+    WriteMultipleDataToFile(Filename, {DataName}, SensorData, Append);
+  }
+
+  void WriteMultipleDataToFile(const string Filename,
+                               const std::vector<string> &DataNames,
+                               const StateDataSet& SensorData,
+                               const bool Append)
+  {
+    /** collect existing streams */
+    std::vector<const StateDataSet::ObjectStream*> Streams;
+    for (const string &DataName : DataNames)
+    {
+      const StateDataSet::ObjectStream* Stream = SensorData.getStream(DataName);
+      if (Stream != nullptr)
+      {
+        Streams.push_back(Stream);
+      }
+    }
 
-    if(!SensorData.getTimeFirst(DataName,Timestamp))
+    if (Streams.empty())
+    {
       return;
+    }
 
     std::ofstream File;
-
     if(Append)
     {
       File.open(Filename, std::ios::out | std::ios::app);
@@ -65,18 +535,258 @@ namespace libRSF
       File.open(Filename, std::ios::out | std::ios::trunc);
     }
 
-    do
+    /** format all states without copying them */
+    string Buffer;
+    Buffer.reserve(WriteBufferSize + 4096);
+    for (const StateDataSet::ObjectStream* Stream : Streams)
     {
-      int NumberOfStates = SensorData.countElement(DataName,Timestamp);
-      for (int nState = 0; nState < NumberOfStates; ++nState)
+      for (const auto &Element : *Stream)
       {
-        Data State;
-        SensorData.getElement(DataName, Timestamp, nState, State);
-        File << State.getName() << ' ' << State.getValueString() << std::endl;
+        const Data &State = Element.second;
+        Buffer.append(GlobalDataConfig.getName(State.getType()));
+        Buffer.push_back(' ');
+        State.appendValueString(Buffer);
+        Buffer.push_back('\n');
+
+        if (Buffer.size() > WriteBufferSize)
+        {
+          File.write(Buffer.data(), Buffer.size());
+          Buffer.clear();
+        }
       }
     }
-    while(SensorData.getTimeNext(DataName, Timestamp, Timestamp));
+    File.write(Buffer.data(), Buffer.size());
 
     File.close();
   }
+
+  /** constants of the binary format */
+  static const char BinaryMagic[4] = {'R', 'S', 'F', 'B'};
+  static const uint32_t BinaryVersion = 1;
+
+  static uint64_t PaddedLength(const uint64_t Length)
+  {
+    return (Length + 7) / 8 * 8;
+  }
+
+  /** write the binary format from lists of objects that share the same type */
+  static bool WriteBinaryBlocks(const string &Filename,
+                                const std::map<DataType, std::vector<const Data*>> &Blocks)
+  {
+    std::ofstream File(Filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!File.is_open())
+    {
+      PRINT_ERROR("Could not open file: ", Filename);
+      return false;
+    }
+
+    auto WriteUInt64 = [&File](const uint64_t Value)
+    {
+      File.write(reinterpret_cast<const char*>(&Value), sizeof(Value));
+    };
+
+    /** header */
+    File.write(BinaryMagic, sizeof(BinaryMagic));
+    File.write(reinterpret_cast<const char*>(&BinaryVersion), sizeof(BinaryVersion));
+    WriteUInt64(Blocks.size());
+
+    for (const auto &Block : Blocks)
+    {
+      /** name of the type */
+      const string &Name = GlobalDataConfig.getName(Block.first);
+      string NamePadded = Name;
+      NamePadded.resize(PaddedLength(Name.size()), '\0');
+      WriteUInt64(Name.size());
+      File.write(NamePadded.data(), NamePadded.size());
+
+      /** size of the block */
+      const uint64_t ValueNumber = GlobalDataConfig.getLayout(Block.first).Size;
+      const uint64_t MeasurementNumber = Block.second.size();
+      WriteUInt64(ValueNumber);
+      WriteUInt64(MeasurementNumber);
+
+      /** write column-wise */
+      std::vector<double> Column(MeasurementNumber);
+      for (uint64_t nValue = 0; nValue < ValueNumber; nValue++)
+      {
+        for (uint64_t nMeasurement = 0; nMeasurement < MeasurementNumber; nMeasurement++)
+        {
+          Column[nMeasurement] = Block.second[nMeasurement]->getBufferPointer()[nValue];
+        }
+        File.write(reinterpret_cast<const char*>(Column.data()), Column.size() * sizeof(double));
+      }
+    }
+
+    if (!File.good())
+    {
+      PRINT_ERROR("Could not write file: ", Filename);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool WriteDataToBinaryFile(const string Filename,
+                             const SensorDataSet& SensorData)
+  {
+    std::map<DataType, std::vector<const Data*>> Blocks;
+    for (const auto &Stream : SensorData)
+    {
+      std::vector<const Data*> &Block = Blocks[Stream.first];
+      for (const auto &Measurement : Stream.second)
+      {
+        Block.push_back(&Measurement.second);
+      }
+    }
+
+    return WriteBinaryBlocks(Filename, Blocks);
+  }
+
+  bool WriteDataToBinaryFile(const string Filename,
+                             const std::vector<string> &DataNames,
+                             const StateDataSet& StateData)
+  {
+    /** states are grouped by their type, like in the ASCII files */
+    std::map<DataType, std::vector<const Data*>> Blocks;
+    for (const string &DataName : DataNames)
+    {
+      const StateDataSet::ObjectStream* Stream = StateData.getStream(DataName);
+      if (Stream == nullptr)
+      {
+        PRINT_WARNING("There is no state: ", DataName);
+        continue;
+      }
+
+      for (const auto &Element : *Stream)
+      {
+        Blocks[Element.second.getType()].push_back(&Element.second);
+      }
+    }
+
+    return WriteBinaryBlocks(Filename, Blocks);
+  }
+
+  bool ReadDataFromBinaryFile(const string Filename,
+                              SensorDataSet& SensorData)
+  {
+    /** map the whole file into memory */
+    const MappedFile File(Filename);
+    if (!File.isOpen() || File.size() < 16)
+    {
+      PRINT_ERROR("Could not open file: ", Filename);
+      return false;
+    }
+
+    const char* const Begin = File.begin();
+    const char* Current = Begin;
+    const char* const End = File.end();
+    bool Success = true;
+
+    /** the sizes in the file are not trusted, so they are compared against the remaining bytes without overflow */
+    auto Remaining = [&Current, End]()
+    {
+      return static_cast<uint64_t>(End - Current);
+    };
+
+    auto ReadUInt64 = [&Current, &Remaining, &Success](uint64_t &Value)
+    {
+      if (Remaining() < sizeof(uint64_t))
+      {
+        Success = false;
+        return;
+      }
+      std::memcpy(&Value, Current, sizeof(uint64_t));
+      Current += sizeof(uint64_t);
+    };
+
+    /** header */
+    uint32_t Version;
+    std::memcpy(&Version, Begin + sizeof(BinaryMagic), sizeof(Version));
+    if (std::memcmp(Begin, BinaryMagic, sizeof(BinaryMagic)) != 0 || Version != BinaryVersion)
+    {
+      PRINT_ERROR("Wrong file format or version: ", Filename);
+      return false;
+    }
+    Current += sizeof(BinaryMagic) + sizeof(Version);
+
+    uint64_t TypeNumber = 0;
+    ReadUInt64(TypeNumber);
+
+    for (uint64_t nType = 0; nType < TypeNumber && Success; nType++)
+    {
+      /** identify type */
+      uint64_t NameLength = 0;
+      ReadUInt64(NameLength);
+      if (!Success || NameLength > Remaining() || PaddedLength(NameLength) > Remaining())
+      {
+        Success = false;
+        break;
+      }
+      const string Name(Current, NameLength);
+      Current += PaddedLength(NameLength);
+
+      uint64_t ValueNumber = 0;
+      uint64_t MeasurementNumber = 0;
+      ReadUInt64(ValueNumber);
+      ReadUInt64(MeasurementNumber);
+
+      if (!Success || !GlobalDataConfig.checkName(Name))
+      {
+        PRINT_ERROR("Type does not exist: ", Name);
+        Success = false;
+        break;
+      }
+
+      const DataType Type = GlobalDataConfig.getType(Name);
+      if (static_cast<uint64_t>(GlobalDataConfig.getLayout(Type).Size) != ValueNumber)
+      {
+        PRINT_ERROR("Wrong number of values for ", Name, ": ", ValueNumber);
+        Success = false;
+        break;
+      }
+
+      if (ValueNumber > 0 && MeasurementNumber > Remaining() / sizeof(double) / ValueNumber)
+      {
+        Success = false;
+        break;
+      }
+
+      /** columns are aligned, so they can be accessed directly */
+      const double* const Columns = reinterpret_cast<const double*>(Current);
+      Data Measurement(Type, 0.0);
+      double* const Buffer = Measurement.getBufferPointer();
+      for (uint64_t nMeasurement = 0; nMeasurement < MeasurementNumber; nMeasurement++)
+      {
+        for (uint64_t nValue = 0; nValue < ValueNumber; nValue++)
+        {
+          Buffer[nValue] = Columns[nValue * MeasurementNumber + nMeasurement];
+        }
+        SensorData.addElement(Type, Measurement.getTimestamp(), Measurement);
+      }
+
+      Current += ValueNumber * MeasurementNumber * sizeof(double);
+    }
+
+    if (!Success)
+    {
+      PRINT_ERROR("File is corrupted: ", Filename);
+    }
+
+    return Success;
+  }
+
+  bool ConvertDataFileToBinary(const string InputFilename,
+                               const string OutputFilename)
+  {
+    SensorDataSet SensorData;
+    ReadDataFromFile(InputFilename, SensorData);
+
+    if (SensorData.empty())
+    {
+      PRINT_ERROR("No data in file: ", InputFilename);
+      return false;
+    }
+
+    return WriteDataToBinaryFile(OutputFilename, SensorData);
+  }
 }
@@ -22,8 +22,44 @@
 
 #include "Marginalization.h"
 
+#include <Eigen/Sparse>
+
+#include <numeric>
+
 namespace libRSF
 {
+  typedef Eigen::SparseMatrix<double, Eigen::RowMajor> SparseMatrixRowMajor;
+  typedef Eigen::SparseMatrix<double, Eigen::ColMajor> SparseMatrixColMajor;
+
+  /** check if a Cholesky decomposition is reliable or if a rank-revealing method is required */
+  static bool IsWellConditioned(const Eigen::LLT<Matrix> &Cholesky, const Matrix &Hessian)
+  {
+    const Vector Diagonal = Cholesky.matrixL().toDenseMatrix().diagonal();
+    const double Tolerance = std::sqrt(std::numeric_limits<double>::epsilon() * Hessian.cols() * Hessian.diagonal().maxCoeff());
+
+    return Diagonal.minCoeff() > Tolerance;
+  }
+
+  static void ConvertToUnsquaredSystem(Matrix &HessRRStar, const Vector &BRStar, const double HessianInflation,
+                                       Vector &ResidualMarg, Matrix &JacobianMarg)
+  {
+    const int SizeRemain = HessRRStar.cols();
+
+    /** add a small uncertainty to prevent accumulation of error (I recommend a value of 1.01)*/
+    if (HessianInflation != 1.0)
+    {
+      HessRRStar /= HessianInflation;
+    }
+
+    /** convert to unsquared system system */
+    ResidualMarg.resize(SizeRemain);
+    JacobianMarg.resize(SizeRemain, SizeRemain);
+    Matrix JacobianMargInv(SizeRemain, SizeRemain);
+
+    RobustSqrtAndInvSqrt(HessRRStar, JacobianMarg, JacobianMargInv);
+    ResidualMarg = JacobianMargInv * BRStar;
+  }
+
 
   void Marginalize(const Vector &Residual, const Matrix &Jacobian,
                    Vector &ResidualMarg, Matrix &JacobianMarg,
@@ -74,19 +110,164 @@ namespace libRSF
     Matrix HessRRStar = HessRR - HessRM * HessMMInv * HessMR;
     const Vector BRStar = BR - HessRM * HessMMInv * BM;
 
-    /** add a small uncertainty to prevent accumulation of error (I recommend a value of 1.01)*/
-    if (HessianInflation != 1.0)
+    /** convert back to Jacobian and residual */
+    ConvertToUnsquaredSystem(HessRRStar, BRStar, HessianInflation, ResidualMarg, JacobianMarg);
+  }
+
+  void MarginalizeSparse(const Vector &Residual, const ceres::CRSMatrix &Jacobian,
+                         Vector &ResidualMarg, Matrix &JacobianMarg,
+                         const std::vector<int> &MarginalBlockSizes, const double HessianInflation)
+  {
+    /** map the CRS Jacobian of ceres without copying it */
+    const Eigen::Map<const SparseMatrixRowMajor> JacobianSparse(Jacobian.num_rows,
+                                                                Jacobian.num_cols,
+                                                                static_cast<int>(Jacobian.values.size()),
+                                                                Jacobian.rows.data(),
+                                                                Jacobian.cols.data(),
+                                                                Jacobian.values.data());
+
+    /** H = J^T * J */
+    SparseMatrixColMajor Hessian = JacobianSparse.transpose() * JacobianSparse;
+    Hessian.prune([](const int, const int, const double Value)
     {
-      HessRRStar /= HessianInflation;
+      return std::abs(Value) > 1e-8;/**< remove small non-zero entries for stability */
+    });
+
+    /** b = J^T * r */
+    const Vector B = JacobianSparse.transpose() * Residual;
+
+    /** calculate size of the linear system */
+    const int SizeMarginal = std::accumulate(MarginalBlockSizes.begin(), MarginalBlockSizes.end(), 0);
+    const int SizeTotal = Hessian.cols();
+    const int SizeRemain = SizeTotal - SizeMarginal;
+
+    /** map each marginalized column to its state block */
+    std::vector<int> ColumnToBlock(SizeMarginal);
+    int Column = 0;
+    for (int Block = 0; Block < static_cast<int>(MarginalBlockSizes.size()); Block++)
+    {
+      for (int n = 0; n < MarginalBlockSizes.at(Block); n++)
+      {
+        ColumnToBlock.at(Column++) = Block;
+      }
     }
 
-    /** convert to unsquared system system */
-    ResidualMarg.resize(SizeRemain);
-    JacobianMarg.resize(SizeRemain, SizeRemain);
-    Matrix JacobianMargInv(SizeRemain, SizeRemain);
+    /** find independent groups of marginalized states (connected components of H_MM) */
+    std::vector<int> BlockParent(MarginalBlockSizes.size());
+    std::iota(BlockParent.begin(), BlockParent.end(), 0);
+    auto FindRoot = [&BlockParent](int Block)
+    {
+      while (BlockParent.at(Block) != Block)
+      {
+        BlockParent.at(Block) = BlockParent.at(BlockParent.at(Block));
+        Block = BlockParent.at(Block);
+      }
+      return Block;
+    };
 
-    RobustSqrtAndInvSqrt(HessRRStar, JacobianMarg, JacobianMargInv);
-    ResidualMarg = JacobianMargInv * BRStar;
+    for (int Col = 0; Col < SizeMarginal; Col++)
+    {
+      for (SparseMatrixColMajor::InnerIterator It(Hessian, Col); It; ++It)
+      {
+        if (It.row() < SizeMarginal)
+        {
+          const int RootRow = FindRoot(ColumnToBlock.at(It.row()));
+          const int RootCol = FindRoot(ColumnToBlock.at(Col));
+          if (RootRow != RootCol)
+          {
+            BlockParent.at(RootRow) = RootCol;
+          }
+        }
+      }
+    }
+
+    /** assign each marginalized column to a group and a position inside this group */
+    std::vector<int> RootToGroup(MarginalBlockSizes.size(), -1);
+    std::vector<int> ColumnToGroup(SizeMarginal);
+    std::vector<int> ColumnToPosition(SizeMarginal);
+    std::vector<std::vector<int>> GroupColumns;
+    for (int Col = 0; Col < SizeMarginal; Col++)
+    {
+      const int Root = FindRoot(ColumnToBlock.at(Col));
+      if (RootToGroup.at(Root) < 0)
+      {
+        RootToGroup.at(Root) = static_cast<int>(GroupColumns.size());
+        GroupColumns.emplace_back();
+      }
+      ColumnToGroup.at(Col) = RootToGroup.at(Root);
+      ColumnToPosition.at(Col) = static_cast<int>(GroupColumns.at(ColumnToGroup.at(Col)).size());
+      GroupColumns.at(ColumnToGroup.at(Col)).push_back(Col);
+    }
+
+    /** gather the dense sub-matrices H_MM and H_MR of each group */
+    const int GroupNumber = static_cast<int>(GroupColumns.size());
+    std::vector<Matrix> HessMM(GroupNumber);
+    std::vector<Matrix> HessMR(GroupNumber);
+    for (int Group = 0; Group < GroupNumber; Group++)
+    {
+      const int GroupSize = static_cast<int>(GroupColumns.at(Group).size());
+      HessMM.at(Group).setZero(GroupSize, GroupSize);
+      HessMR.at(Group).setZero(GroupSize, SizeRemain);
+    }
+
+    for (int Col = 0; Col < SizeTotal; Col++)
+    {
+      for (SparseMatrixColMajor::InnerIterator It(Hessian, Col); It; ++It)
+      {
+        const int Row = It.row();
+        if (Row >= SizeMarginal)
+        {
+          continue;
+        }
+
+        const int Group = ColumnToGroup.at(Row);
+        if (Col < SizeMarginal)
+        {
+          HessMM.at(Group)(ColumnToPosition.at(Row), ColumnToPosition.at(Col)) = It.value();
+        }
+        else
+        {
+          HessMR.at(Group)(ColumnToPosition.at(Row), Col - SizeMarginal) = It.value();
+        }
+      }
+    }
+
+    /** start with H_RR and r_R */
+    Matrix HessRRStar = Matrix(Hessian.bottomRightCorner(SizeRemain, SizeRemain));
+    Vector BRStar = B.tail(SizeRemain);
+
+    /** subtract the Schur complement of each group separately */
+    for (int Group = 0; Group < GroupNumber; Group++)
+    {
+      const int GroupSize = static_cast<int>(GroupColumns.at(Group).size());
+
+      /** solve for [H_MR, b_M] at once */
+      Matrix RightHandSide(GroupSize, SizeRemain + 1);
+      RightHandSide.leftCols(SizeRemain) = HessMR.at(Group);
+      for (int n = 0; n < GroupSize; n++)
+      {
+        RightHandSide(n, SizeRemain) = B(GroupColumns.at(Group).at(n));
+      }
+
+      Matrix Solution;
+      Eigen::LLT<Matrix> CholHess(HessMM.at(Group));
+      if (CholHess.info() == Eigen::Success && IsWellConditioned(CholHess, HessMM.at(Group)))
+      {
+        Solution = CholHess.solve(RightHandSide);
+      }
+      else
+      {
+        /** pseudo-inverse for rank deficient matrices */
+        Eigen::CompleteOrthogonalDecomposition<Matrix> CODHess(HessMM.at(Group));
+        Solution = CODHess.pseudoInverse() * RightHandSide;
+      }
+
+      HessRRStar.noalias() -= HessMR.at(Group).transpose() * Solution.leftCols(SizeRemain);
+      BRStar.noalias() -= HessMR.at(Group).transpose() * Solution.col(SizeRemain);
+    }
+
+    /** convert back to Jacobian and residual */
+    ConvertToUnsquaredSystem(HessRRStar, BRStar, HessianInflation, ResidualMarg, JacobianMarg);
   }
 
 }
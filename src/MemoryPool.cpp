@@ -0,0 +1,146 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+#include "MemoryPool.h"
+
+#include <algorithm>
+#include <array>
+
+namespace libRSF
+{
+  MemoryPool::MemoryPool(const size_t BlockSize, const size_t BlocksPerChunk) : _BlocksPerChunk(BlocksPerChunk), _FreeList(nullptr)
+  {
+    /** every block has to hold the free list pointer and has to be aligned */
+    _BlockSize = ((std::max(BlockSize, sizeof(FreeBlock)) + Granularity - 1) / Granularity) * Granularity;
+  }
+
+  MemoryPool::~MemoryPool()
+  {
+    for (void* Chunk : _Chunks)
+    {
+      ::operator delete(Chunk);
+    }
+  }
+
+  void* MemoryPool::allocate()
+  {
+    std::lock_guard<std::mutex> Lock(_Mutex);
+
+    if (_FreeList == nullptr)
+    {
+      this->addChunk();
+    }
+
+    FreeBlock* Block = _FreeList;
+    _FreeList = Block->Next;
+    return Block;
+  }
+
+  void MemoryPool::deallocate(void* Pointer)
+  {
+    if (Pointer == nullptr)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> Lock(_Mutex);
+
+    FreeBlock* Block = static_cast<FreeBlock*>(Pointer);
+    Block->Next = _FreeList;
+    _FreeList = Block;
+  }
+
+  size_t MemoryPool::getBlockSize() const
+  {
+    return _BlockSize;
+  }
+
+  void MemoryPool::addChunk()
+  {
+    char* Chunk = static_cast<char*>(::operator new(_BlockSize * _BlocksPerChunk));
+    _Chunks.push_back(Chunk);
+
+    /** link all blocks of the new chunk */
+    for (size_t n = 0; n < _BlocksPerChunk; ++n)
+    {
+      FreeBlock* Block = reinterpret_cast<FreeBlock*>(Chunk + n * _BlockSize);
+      Block->Next = _FreeList;
+      _FreeList = Block;
+    }
+  }
+
+  MemoryPool* MemoryPool::Get(const size_t Size)
+  {
+    constexpr size_t PoolNumber = MaxObjectSize / Granularity;
+
+    /** the pools are never destroyed, because static objects could free their memory at exit */
+    static std::array<MemoryPool*, PoolNumber>* Pools = []()
+    {
+      auto* NewPools = new std::array<MemoryPool*, PoolNumber>;
+      for (size_t n = 0; n < PoolNumber; ++n)
+      {
+        (*NewPools)[n] = new MemoryPool((n + 1) * Granularity);
+      }
+      return NewPools;
+    }();
+
+    if (Size == 0 || Size > MaxObjectSize)
+    {
+      return nullptr;
+    }
+    return (*Pools)[(Size - 1) / Granularity];
+  }
+
+  void* PoolAllocated::operator new (const size_t Size)
+  {
+    MemoryPool* Pool = MemoryPool::Get(Size);
+    if (Pool == nullptr)
+    {
+      return ::operator new(Size);
+    }
+    return Pool->allocate();
+  }
+
+  void PoolAllocated::operator delete (void* Pointer, const size_t Size)
+  {
+    MemoryPool* Pool = MemoryPool::Get(Size);
+    if (Pool == nullptr)
+    {
+      ::operator delete(Pointer);
+    }
+    else
+    {
+      Pool->deallocate(Pointer);
+    }
+  }
+
+  void* PoolAllocated::operator new (const size_t Size, const std::align_val_t Alignment)
+  {
+    return ::operator new(Size, Alignment);
+  }
+
+  void PoolAllocated::operator delete (void* Pointer, const size_t Size, const std::align_val_t Alignment)
+  {
+    ::operator delete(Pointer, Alignment);
+  }
+}
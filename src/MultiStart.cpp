@@ -0,0 +1,126 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+#include "MultiStart.h"
+#include "Misc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace libRSF
+{
+  bool SolveMultiStart(const GraphBuilder &Builder,
+                       const ceres::Solver::Options &Options,
+                       const StateID &State,
+                       const VectorVectorSTL<Dynamic> &InitialValues,
+                       StateDataSet &PreOptimizationData,
+                       StateDataSet &PostOptimizationData,
+                       StateDataSet &SolverData,
+                       const string &SummaryName,
+                       int ThreadNumber)
+  {
+    const int RunNumber = static_cast<int>(InitialValues.size());
+
+    if (ThreadNumber <= 0)
+    {
+      ThreadNumber = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    ThreadNumber = std::max(1, std::min(ThreadNumber, RunNumber));
+
+    /** preallocated results, one slot per run */
+    std::vector<Data> PreStates(RunNumber);
+    std::vector<Data> PostStates(RunNumber);
+    std::vector<double> Durations(RunNumber);
+    std::vector<int> Iterations(RunNumber);
+
+    /** the runs are distributed dynamically, since their duration differs a lot */
+    std::atomic<int> NextRun(0);
+    std::atomic<int> FinishedRuns(0);
+    std::atomic<bool> BuildFailed(false);
+
+    auto Worker = [&](const bool PrintProgress)
+    {
+      /** every worker owns an independent copy of the problem */
+      FactorGraph Graph;
+      if (Builder(Graph) == false)
+      {
+        BuildFailed = true;
+        return;
+      }
+      Data &StateData = Graph.getStateData().getElement(State.ID, State.Timestamp, State.Number);
+
+      for (int nRun = NextRun++; nRun < RunNumber && BuildFailed == false; nRun = NextRun++)
+      {
+        /** init state with value */
+        StateData.setMean(InitialValues.at(nRun));
+        PreStates.at(nRun) = StateData;
+
+        /** optimize */
+        Graph.solve(Options);
+
+        /** save result */
+        PostStates.at(nRun) = StateData;
+        Durations.at(nRun) = Graph.getSolverDurationAndReset();
+        Iterations.at(nRun) = Graph.getSolverIterationsAndReset();
+
+        FinishedRuns++;
+        if (PrintProgress)
+        {
+          libRSF::PrintProgress((100.0 * FinishedRuns) / RunNumber);
+        }
+      }
+    };
+
+    /** the calling thread is the first worker */
+    std::vector<std::thread> Threads;
+    for (int nThread = 1; nThread < ThreadNumber; ++nThread)
+    {
+      Threads.emplace_back(Worker, false);
+    }
+    Worker(true);
+    for (std::thread &Thread : Threads)
+    {
+      Thread.join();
+    }
+
+    if (BuildFailed)
+    {
+      PRINT_ERROR("Could not create the graph for the multi-start optimization!");
+      return false;
+    }
+
+    /** store everything in the order of the initial values */
+    for (int nRun = 0; nRun < RunNumber; ++nRun)
+    {
+      PreOptimizationData.addElement(State.ID, PreStates.at(nRun));
+      PostOptimizationData.addElement(State.ID, PostStates.at(nRun));
+
+      Data Summary(DataType::IterationSummary, State.Timestamp);
+      Summary.setValueScalar(DataElement::DurationSolver, Durations.at(nRun));
+      Summary.setValueScalar(DataElement::IterationSolver, Iterations.at(nRun));
+      SolverData.addElement(SummaryName, Summary);
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,235 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+#include "SensorDataSource.h"
+
+namespace libRSF
+{
+  SensorDataSource::SensorDataSource(const size_t Capacity, const double ReorderDelay)
+    : _Queue(Capacity), _Finished(false), _ReorderDelay(ReorderDelay),
+      _LatestTimestamp(-std::numeric_limits<double>::infinity()),
+      _ReleasedUntil(-std::numeric_limits<double>::infinity()),
+      _Dropped(0)
+  {}
+
+  bool SensorDataSource::push(const Data &Measurement)
+  {
+    return _Queue.push({Measurement, Clock::now()});
+  }
+
+  void SensorDataSource::pushBlocking(const Data &Measurement)
+  {
+    const Entry NewEntry = {Measurement, Clock::now()};
+    while (!_Queue.push(NewEntry))
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void SensorDataSource::finish()
+  {
+    _Finished.store(true, std::memory_order_release);
+  }
+
+  void SensorDataSource::drainQueue()
+  {
+    Entry NewEntry;
+    while (_Queue.pop(NewEntry))
+    {
+      const double Timestamp = NewEntry.Measurement.getTimestamp();
+
+      /** this part of the timeline was already passed to the estimator */
+      if (Timestamp <= _ReleasedUntil)
+      {
+        /** warn only once, the number is available with getDroppedNumber() */
+        if (_Dropped == 0)
+        {
+          PRINT_WARNING("Measurement at ", Timestamp, " arrived too late and is dropped! Consider a larger reorder delay.");
+        }
+        _Dropped++;
+        continue;
+      }
+
+      _LatestTimestamp = std::max(_LatestTimestamp, Timestamp);
+      _ReorderBuffer.emplace(Tick(Timestamp), NewEntry);
+    }
+  }
+
+  double SensorDataSource::getWatermark() const
+  {
+    if (_Finished.load(std::memory_order_acquire) && _Queue.empty())
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    return _LatestTimestamp - _ReorderDelay;
+  }
+
+  bool SensorDataSource::pullBatch(SensorDataSet &Batch)
+  {
+    const bool Finished = _Finished.load(std::memory_order_acquire);
+    this->drainQueue();
+
+    if (_ReorderBuffer.empty())
+    {
+      return false;
+    }
+
+    /** the newest timestamps could still be incomplete, so the automatic watermark is exclusive */
+    if (Finished && _Queue.empty())
+    {
+      return this->release(_ReorderBuffer.end(), Batch);
+    }
+    return this->release(_ReorderBuffer.lower_bound(Tick(_LatestTimestamp - _ReorderDelay)), Batch);
+  }
+
+  bool SensorDataSource::pullBatch(const double Watermark, SensorDataSet &Batch)
+  {
+    this->drainQueue();
+
+    if (_ReorderBuffer.empty())
+    {
+      return false;
+    }
+
+    /** an explicit watermark is inclusive */
+    if (Watermark >= _LatestTimestamp)
+    {
+      return this->release(_ReorderBuffer.end(), Batch);
+    }
+    return this->release(_ReorderBuffer.upper_bound(Tick(Watermark)), Batch);
+  }
+
+  bool SensorDataSource::release(const std::multimap<Tick, Entry>::iterator End, SensorDataSet &Batch)
+  {
+    if (End == _ReorderBuffer.begin())
+    {
+      return false;
+    }
+
+    /** pass everything before End in time order */
+    _OldestArrival = _ReorderBuffer.begin()->second.Arrival;
+    for (auto It = _ReorderBuffer.begin(); It != End; ++It)
+    {
+      _OldestArrival = std::min(_OldestArrival, It->second.Arrival);
+      Batch.addElement(It->second.Measurement);
+    }
+    _ReleasedUntil = std::prev(End)->first;
+    _ReorderBuffer.erase(_ReorderBuffer.begin(), End);
+
+    return true;
+  }
+
+  bool SensorDataSource::isFinished()
+  {
+    const bool Finished = _Finished.load(std::memory_order_acquire);
+    this->drainQueue();
+    return Finished && _Queue.empty() && _ReorderBuffer.empty();
+  }
+
+  double SensorDataSource::getLatency() const
+  {
+    /** nothing was released yet */
+    if (_OldestArrival == Clock::time_point())
+    {
+      return 0.0;
+    }
+    return std::chrono::duration<double>(Clock::now() - _OldestArrival).count();
+  }
+
+  int SensorDataSource::getDroppedNumber() const
+  {
+    return _Dropped;
+  }
+
+  FileReplaySource::FileReplaySource(const std::string &Filename, SensorDataSource &Target, const double Speed)
+    : _Filename(Filename), _Target(Target), _Speed(Speed), _Stop(false)
+  {}
+
+  FileReplaySource::~FileReplaySource()
+  {
+    this->stop();
+  }
+
+  void FileReplaySource::start()
+  {
+    if (_Thread.joinable())
+    {
+      PRINT_WARNING("Replay of ", _Filename, " is already running!");
+      return;
+    }
+
+    _Stop = false;
+    _Thread = std::thread(&FileReplaySource::run, this);
+  }
+
+  void FileReplaySource::stop()
+  {
+    _Stop = true;
+    if (_Thread.joinable())
+    {
+      _Thread.join();
+    }
+  }
+
+  void FileReplaySource::run()
+  {
+    /** files are not necessarily ordered by time over all types, so they are merged while streaming */
+    bool First = true;
+    double TimestampFirst = 0.0;
+    SensorDataSource::Clock::time_point Start;
+
+    ReadDataFromFileInTimeOrder(_Filename, [&](const Data &Measurement)
+    {
+      if (First)
+      {
+        TimestampFirst = Measurement.getTimestamp();
+        Start = SensorDataSource::Clock::now();
+        First = false;
+      }
+
+      /** simulate the rate of the original recording */
+      if (_Speed > 0.0)
+      {
+        const std::chrono::duration<double> Offset((Measurement.getTimestamp() - TimestampFirst) / _Speed);
+        std::this_thread::sleep_until(Start + std::chrono::duration_cast<SensorDataSource::Clock::duration>(Offset));
+      }
+
+      /** wait for free space in the queue */
+      while (!_Target.push(Measurement))
+      {
+        if (_Stop)
+        {
+          return false;
+        }
+        std::this_thread::yield();
+      }
+
+      return _Stop == false;
+    });
+
+    if (_Stop == false)
+    {
+      _Target.finish();
+    }
+  }
+}
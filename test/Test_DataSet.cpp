@@ -0,0 +1,196 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_DataSet.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks the eviction of the retention policy.
+ * @copyright GNU Public License.
+ *
+ */
+
+#include "StateDataSet.h"
+#include "DataStream.h"
+#include "gtest/gtest.h"
+
+typedef std::vector<std::pair<std::string, double>> EvictionList;
+
+/** create a data set with two IDs, the elements are added out of order */
+static void CreateDataSet(libRSF::StateDataSet &Set)
+{
+  for (const double Timestamp : {3.0, 1.0, 5.0, 2.0, 4.0})
+  {
+    Set.addElement("A", Timestamp, libRSF::Data(libRSF::DataType::Point1, Timestamp));
+  }
+  for (const double Timestamp : {4.5, 0.5})
+  {
+    Set.addElement("B", Timestamp, libRSF::Data(libRSF::DataType::Point1, Timestamp));
+  }
+}
+
+/** configure the policy with a spill callback that records the evicted elements */
+static void SetPolicy(libRSF::StateDataSet &Set, const double MaxAge, const int MaxCount, EvictionList &Evicted)
+{
+  libRSF::StateDataSet::RetentionPolicy Policy;
+  Policy.MaxAge = MaxAge;
+  Policy.MaxCount = MaxCount;
+  Policy.Spill = [&Evicted](const std::string &ID, const double Timestamp, const libRSF::Data &Object)
+  {
+    EXPECT_DOUBLE_EQ(Object.getTimestamp(), Timestamp);
+    Evicted.emplace_back(ID, Timestamp);
+  };
+  Set.setRetentionPolicy(Policy);
+}
+
+TEST(DataSet, RetentionUnlimited)
+{
+  libRSF::StateDataSet Set;
+  CreateDataSet(Set);
+
+  EXPECT_EQ(Set.applyRetentionPolicy(), 0);
+  EXPECT_EQ(Set.countElements("A"), 5);
+  EXPECT_EQ(Set.countElements("B"), 2);
+}
+
+TEST(DataSet, RetentionMaxCount)
+{
+  libRSF::StateDataSet Set;
+  CreateDataSet(Set);
+
+  EvictionList Evicted;
+  SetPolicy(Set, std::numeric_limits<double>::infinity(), 2, Evicted);
+
+  /** the oldest elements of each ID are evicted in time order */
+  EXPECT_EQ(Set.applyRetentionPolicy(), 3);
+  EXPECT_EQ(Evicted, EvictionList({{"A", 1.0}, {"A", 2.0}, {"A", 3.0}}));
+
+  double Time;
+  ASSERT_TRUE(Set.getTimeFirst("A", Time));
+  EXPECT_DOUBLE_EQ(Time, 4.0);
+  EXPECT_EQ(Set.countElements("A"), 2);
+  EXPECT_EQ(Set.countElements("B"), 2);
+}
+
+TEST(DataSet, RetentionMaxCountKeepsFuture)
+{
+  libRSF::StateDataSet Set;
+  CreateDataSet(Set);
+
+  EvictionList Evicted;
+  SetPolicy(Set, std::numeric_limits<double>::infinity(), 1, Evicted);
+
+  /** elements after the given time are not counted and never evicted */
+  EXPECT_EQ(Set.applyRetentionPolicy(2.0), 1);
+  EXPECT_EQ(Evicted, EvictionList({{"A", 1.0}}));
+  EXPECT_EQ(Set.countElements("A"), 4);
+  EXPECT_EQ(Set.countElements("B"), 2);
+
+  Evicted.clear();
+  EXPECT_EQ(Set.applyRetentionPolicy(4.0), 2);
+  EXPECT_EQ(Evicted, EvictionList({{"A", 2.0}, {"A", 3.0}}));
+  EXPECT_TRUE(Set.checkElement("A", 5.0));
+  EXPECT_TRUE(Set.checkElement("B", 0.5));
+}
+
+TEST(DataSet, RetentionMaxAge)
+{
+  libRSF::StateDataSet Set;
+  CreateDataSet(Set);
+
+  EvictionList Evicted;
+  SetPolicy(Set, 2.0, 0, Evicted);
+
+  /** relative to the newest element at 5.0, everything before 3.0 expires */
+  EXPECT_EQ(Set.applyRetentionPolicy(), 3);
+  EXPECT_EQ(Evicted, EvictionList({{"A", 1.0}, {"A", 2.0}, {"B", 0.5}}));
+  EXPECT_EQ(Set.countElements("A"), 3);
+  EXPECT_EQ(Set.countElements("B"), 1);
+
+  /** an explicit time can remove complete IDs */
+  Evicted.clear();
+  EXPECT_EQ(Set.applyRetentionPolicy(7.0), 3);
+  EXPECT_EQ(Evicted, EvictionList({{"A", 3.0}, {"A", 4.0}, {"B", 4.5}}));
+  EXPECT_FALSE(Set.checkID("B"));
+  EXPECT_EQ(Set.countElements("A"), 1);
+}
+
+TEST(DataSet, ContiguousStreamSlidingWindow)
+{
+  libRSF::DataStreamContiguous<double> Stream;
+  Stream.emplace(0.0, 0.0);
+
+  /** a window of ten elements, the storage must not grow with the number of insertions */
+  for (int n = 1; n < 1000; n++)
+  {
+    Stream.emplace(n, n);
+    if (Stream.size() > 10)
+    {
+      Stream.erase(Stream.begin());
+    }
+    EXPECT_LE(Stream.storageSize(), 11u);
+  }
+  ASSERT_EQ(Stream.size(), 10u);
+
+  /** the remaining objects are still at their keys */
+  double Expected = 990.0;
+  for (auto It = Stream.begin(); It != Stream.end(); ++It)
+  {
+    EXPECT_EQ(It->second, Expected);
+    EXPECT_EQ(It->first, libRSF::Tick(Expected));
+    Expected += 1.0;
+  }
+}
+
+TEST(DataSet, ContiguousStreamKeepsAddresses)
+{
+  libRSF::DataStreamContiguous<double> Stream;
+  std::vector<const double*> Addresses;
+  for (int n = 0; n < 10; n++)
+  {
+    Addresses.push_back(&Stream.emplace(n, n)->second);
+  }
+
+  /** removing in the middle and at both ends does not move the other objects */
+  Stream.erase(5.0);
+  Stream.erase(Stream.begin());
+  Stream.erase(9.0);
+  for (const int n : {1, 2, 3, 4, 6, 7, 8})
+  {
+    EXPECT_EQ(&Stream.find(n)->second, Addresses.at(n));
+    EXPECT_EQ(*Addresses.at(n), n);
+  }
+
+  /** the free slot in the middle is reused, the ones at both ends are released */
+  EXPECT_EQ(Stream.storageSize(), 8u);
+  Stream.emplace(10.0, 10.0);
+  EXPECT_EQ(Stream.storageSize(), 8u);
+  EXPECT_EQ(&Stream.find(10.0)->second, Addresses.at(5));
+
+  /** an empty stream releases everything */
+  Stream.erase(Stream.begin(), Stream.end());
+  EXPECT_TRUE(Stream.empty());
+  EXPECT_EQ(Stream.storageSize(), 0u);
+}
+
+// main provided by linking to gtest_main
@@ -0,0 +1,229 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_EstimationPipeline.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks the epoch loop of the estimation pipeline for different solution types.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "EstimationPipeline.h"
+#include "gtest/gtest.h"
+
+#define POSITION_STATE "Position"
+
+/** position measurements of a 1D random walk */
+static const std::vector<double> Positions = {0.0, 1.0, 3.0, 2.0, 4.0, 5.0};
+
+static void CreateMeasurements(libRSF::SensorDataSet &Measurements)
+{
+  for (size_t n = 0; n < Positions.size(); n++)
+  {
+    libRSF::Data Measurement(libRSF::DataType::Point1, static_cast<double>(n));
+    Measurement.setMean(libRSF::Vector1::Constant(Positions.at(n)));
+    Measurements.addElement(Measurement);
+  }
+}
+
+static libRSF::FactorGraphConfig CreateConfig(const libRSF::SolutionType Type)
+{
+  libRSF::FactorGraphConfig Config;
+  Config.Solution.Type = Type;
+  Config.Solution.MaxTime = 1.0;
+  Config.Solution.MaxIterations = 100;
+  Config.Solution.IsAsync = false;
+  Config.Solution.AsyncRate = 0.0;
+  Config.Solution.SyncSensor = libRSF::DataType::Point1;
+  Config.Solution.EstimateCov = false;
+  Config.Solution.Marginalize = false;
+  Config.Solution.WindowLength = 1.5;
+  Config.SolverConfig.minimizer_progress_to_stdout = false;
+  Config.SolverConfig.num_threads = 1;
+  return Config;
+}
+
+/** one state per epoch with its position measurement and a random walk to the previous one */
+class EpochBuilder
+{
+  public:
+    EpochBuilder()
+    {
+      _Measurement.setStdDevSharedDiagonal(1.0);
+      _RandomWalk.setStdDevSharedDiagonal(0.5);
+    }
+
+    void operator()(libRSF::FactorGraph &Graph, libRSF::SensorDataSet &Measurements, const double TimeOld, const double TimeNow)
+    {
+      Graph.addState(POSITION_STATE, libRSF::DataType::Point1, TimeNow);
+      if (Measurements.checkElement(libRSF::DataType::Point1, TimeNow))
+      {
+        Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, TimeNow, 0),
+                                                      Measurements.getElement(libRSF::DataType::Point1, TimeNow), _Measurement);
+      }
+      else
+      {
+        MissingMeasurements++;
+      }
+      if (TimeNow > TimeOld)
+      {
+        Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, TimeOld, 0),
+                                                             libRSF::StateID(POSITION_STATE, TimeNow, 0),
+                                                             libRSF::Data(libRSF::DataType::Point1, TimeNow), _RandomWalk);
+      }
+      TimesOld.emplace_back(TimeOld);
+    }
+
+    std::vector<double> TimesOld;
+    int MissingMeasurements = 0;
+
+  private:
+    libRSF::GaussianDiagonal<1> _Measurement;
+    libRSF::GaussianDiagonal<1> _RandomWalk;
+};
+
+static void SaveResult(libRSF::FactorGraph &Graph, const double TimeNow, libRSF::StateDataSet &Result)
+{
+  Result.addElement(POSITION_STATE, TimeNow, Graph.getStateData().getElement(POSITION_STATE, TimeNow));
+}
+
+static double GetPosition(const libRSF::StateDataSet &States, const double Timestamp)
+{
+  libRSF::Data State;
+  EXPECT_TRUE(States.getElement(POSITION_STATE, Timestamp, 0, State));
+  return State.getMean()(0);
+}
+
+TEST(EstimationPipeline, EpochsFollowSyncSensor)
+{
+  libRSF::SensorDataSet Measurements;
+  CreateMeasurements(Measurements);
+
+  EpochBuilder Builder;
+  libRSF::EstimationPipeline Pipeline(CreateConfig(libRSF::SolutionType::Smoother), std::ref(Builder), SaveResult);
+
+  libRSF::FactorGraph Graph;
+  libRSF::StateDataSet Result;
+  ASSERT_TRUE(Pipeline.run(Graph, Measurements, Result));
+
+  /** the first epoch has no predecessor */
+  EXPECT_EQ(Builder.TimesOld, std::vector<double>({0.0, 0.0, 1.0, 2.0, 3.0, 4.0}));
+  EXPECT_EQ(Result.countElements(POSITION_STATE), static_cast<int>(Positions.size()));
+  EXPECT_EQ(Pipeline.getTiming().countElements(libRSF::EstimationPipeline::TimingName), static_cast<int>(Positions.size()));
+}
+
+TEST(EstimationPipeline, BatchEqualsManualSolve)
+{
+  const libRSF::FactorGraphConfig Config = CreateConfig(libRSF::SolutionType::Batch);
+
+  libRSF::SensorDataSet Measurements;
+  CreateMeasurements(Measurements);
+
+  EpochBuilder Builder;
+  libRSF::EstimationPipeline Pipeline(Config, std::ref(Builder), SaveResult);
+  libRSF::FactorGraph Graph;
+  libRSF::StateDataSet Result;
+  ASSERT_TRUE(Pipeline.run(Graph, Measurements, Result));
+
+  /** the same graph, solved once by hand */
+  EpochBuilder ManualBuilder;
+  libRSF::FactorGraph ManualGraph;
+  double TimeOld = 0.0;
+  for (size_t n = 0; n < Positions.size(); n++)
+  {
+    ManualBuilder(ManualGraph, Measurements, TimeOld, static_cast<double>(n));
+    TimeOld = static_cast<double>(n);
+  }
+  ManualGraph.solve(Config.SolverConfig);
+
+  EXPECT_EQ(Pipeline.getTiming().countElements(libRSF::EstimationPipeline::TimingName), 1);
+  for (size_t n = 0; n < Positions.size(); n++)
+  {
+    EXPECT_NEAR(GetPosition(Result, n), GetPosition(ManualGraph.getStateData(), n), 1e-6);
+  }
+}
+
+TEST(EstimationPipeline, WindowRemovesOldStates)
+{
+  libRSF::SensorDataSet Measurements;
+  CreateMeasurements(Measurements);
+
+  EpochBuilder Builder;
+  libRSF::EstimationPipeline Pipeline(CreateConfig(libRSF::SolutionType::Window), std::ref(Builder), SaveResult);
+
+  libRSF::FactorGraph Graph;
+  libRSF::StateDataSet Result;
+  ASSERT_TRUE(Pipeline.run(Graph, Measurements, Result));
+
+  /** the window of 1.5s keeps the two newest states, the result contains all */
+  EXPECT_EQ(Graph.getStateData().countElements(POSITION_STATE), 2);
+  EXPECT_EQ(Result.countElements(POSITION_STATE), static_cast<int>(Positions.size()));
+}
+
+TEST(EstimationPipeline, RetentionPolicyIsApplied)
+{
+  libRSF::SensorDataSet Measurements;
+  CreateMeasurements(Measurements);
+
+  EpochBuilder Builder;
+  libRSF::EstimationPipeline Pipeline(CreateConfig(libRSF::SolutionType::Smoother), std::ref(Builder), SaveResult);
+
+  libRSF::FactorGraph Graph;
+  libRSF::StateDataSet Result;
+  libRSF::StateDataSet::RetentionPolicy Policy;
+  Policy.MaxCount = 3;
+  Result.setRetentionPolicy(Policy);
+  ASSERT_TRUE(Pipeline.run(Graph, Measurements, Result));
+
+  /** only the newest results remain */
+  EXPECT_EQ(Result.countElements(POSITION_STATE), 3);
+  EXPECT_FALSE(Result.checkElement(POSITION_STATE, 2.0));
+  EXPECT_TRUE(Result.checkElement(POSITION_STATE, 5.0));
+}
+
+TEST(EstimationPipeline, RetentionKeepsFutureMeasurements)
+{
+  libRSF::SensorDataSet Measurements;
+  CreateMeasurements(Measurements);
+
+  /** the measurements are loaded in advance, the policy must not evict those of later epochs */
+  libRSF::SensorDataSet::RetentionPolicy Policy;
+  Policy.MaxCount = 1;
+  Measurements.setRetentionPolicy(Policy);
+
+  EpochBuilder Builder;
+  libRSF::EstimationPipeline Pipeline(CreateConfig(libRSF::SolutionType::Smoother), std::ref(Builder), SaveResult);
+
+  libRSF::FactorGraph Graph;
+  libRSF::StateDataSet Result;
+  ASSERT_TRUE(Pipeline.run(Graph, Measurements, Result));
+
+  EXPECT_EQ(Builder.MissingMeasurements, 0);
+  EXPECT_EQ(Builder.TimesOld.size(), Positions.size());
+  EXPECT_EQ(Measurements.countElements(libRSF::DataType::Point1), 1);
+}
+
+// main provided by linking to gtest_main
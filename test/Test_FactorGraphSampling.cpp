@@ -0,0 +1,119 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_FactorGraphSampling.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Compares the sampled cost surface against ceres::Problem::Evaluate.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "FactorGraphSampling.h"
+#include "VectorMath.h"
+#include "gtest/gtest.h"
+
+/** non-linear 2D prior, scaled to unit variance */
+struct RangeCost
+{
+  template <typename T>
+  bool operator()(const T* const State, T* Residual) const
+  {
+    Residual[0] = sqrt(T(1.0) + State[0] * State[0] + State[1] * State[1]) - T(2.0);
+    Residual[1] = State[0] - T(0.5) * State[1];
+    return true;
+  }
+};
+
+/** difference to a second state */
+struct BetweenCost
+{
+  template <typename T>
+  bool operator()(const T* const Old, const T* const New, T* Residual) const
+  {
+    Residual[0] = New[0] - Old[0] - T(1.0);
+    Residual[1] = New[1] - Old[1];
+    return true;
+  }
+};
+
+TEST(FactorGraphSampling, CostSurfaceMatchesEvaluate)
+{
+  double State[2] = {0.5, -1.0};
+  double Other[2] = {0.0, 0.0};
+
+  ceres::CauchyLoss Loss(0.5);
+  ceres::Problem::Options ProblemOptions;
+  ProblemOptions.loss_function_ownership = ceres::DO_NOT_TAKE_OWNERSHIP;
+  ceres::Problem Graph(ProblemOptions);
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<RangeCost, 2, 2>(new RangeCost()), &Loss, State);
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<BetweenCost, 2, 2, 2>(new BetweenCost()), nullptr, Other, State);
+
+  const int Points = 3;
+  libRSF::StateDataSet Result;
+  libRSF::EvaluateCostSurface<2>(Graph, State, Points, 2.0, Result);
+
+  /** the problem is not modified */
+  EXPECT_EQ(State[0], 0.5);
+  EXPECT_EQ(State[1], -1.0);
+
+  std::vector<libRSF::Data> Surface;
+  for (const std::string &Name : Result.getKeysAll())
+  {
+    const std::vector<libRSF::Data> Elements = Result.getElementsOfID(Name);
+    Surface.insert(Surface.end(), Elements.begin(), Elements.end());
+  }
+  ASSERT_EQ(static_cast<int>(Surface.size()), Points * Points);
+
+  ceres::Problem::EvaluateOptions Options;
+  Options.apply_loss_function = true;
+  Options.num_threads = 1;
+  Options.parameter_blocks = {State};
+
+  /** evaluate the problem directly at each grid point */
+  for (const libRSF::Data &Point : Surface)
+  {
+    State[0] = Point.getMean()(0);
+    State[1] = Point.getMean()(1);
+
+    double Cost;
+    std::vector<double> Gradient;
+    ceres::CRSMatrix JacobianCRS;
+    ASSERT_TRUE(Graph.Evaluate(Options, &Cost, nullptr, &Gradient, &JacobianCRS));
+
+    libRSF::Matrix Jacobian;
+    libRSF::CRSToMatrix(JacobianCRS, Jacobian);
+    const libRSF::Matrix Hessian = Jacobian.transpose() * Jacobian;
+
+    EXPECT_NEAR(Point.getValue(libRSF::DataElement::Cost)(0), Cost, 1e-9) << Point.getMean().transpose();
+    EXPECT_NEAR(Point.getValue(libRSF::DataElement::Gradient)(0), Gradient.at(0), 1e-9) << Point.getMean().transpose();
+    EXPECT_NEAR(Point.getValue(libRSF::DataElement::Gradient)(1), Gradient.at(1), 1e-9) << Point.getMean().transpose();
+
+    const libRSF::Vector HessianVector = Point.getValue(libRSF::DataElement::Hessian);
+    EXPECT_TRUE(Eigen::Map<const libRSF::Matrix22>(HessianVector.data()).isApprox(Hessian, 1e-9)) << Point.getMean().transpose();
+  }
+}
+
+// main provided by linking to gtest_main
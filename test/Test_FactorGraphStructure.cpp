@@ -0,0 +1,206 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_FactorGraphStructure.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks the bookkeeping of factors with stable numbers after removals.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "FactorGraph.h"
+#include "gtest/gtest.h"
+
+static libRSF::Data CreateMeasurement(const double Timestamp, const double Value)
+{
+  libRSF::Data Measurement(libRSF::DataType::Point1, Timestamp);
+  Measurement.setMean(libRSF::Vector1::Constant(Value));
+  return Measurement;
+}
+
+/** two priors at each timestamp, the first on state "A" and the second on state "B" */
+static void BuildGraph(libRSF::FactorGraph &Graph, libRSF::GaussianDiagonal<1> &Noise, const int Length)
+{
+  for (int n = 0; n < Length; n++)
+  {
+    const double Timestamp = n;
+    for (const std::string Name : {"A", "B"})
+    {
+      Graph.addState(Name, libRSF::DataType::Point1, Timestamp);
+      Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(Name, Timestamp, 0), CreateMeasurement(Timestamp, 0.0), Noise);
+    }
+  }
+}
+
+static std::vector<libRSF::FactorID> GetFactors(const libRSF::FactorGraph &Graph, const std::string &Name, const double Timestamp)
+{
+  std::vector<libRSF::FactorID> Factors;
+  Graph.getFactorsOfState(Name, Timestamp, 0, Factors);
+  return Factors;
+}
+
+TEST(FactorGraphStructure, NumbersAreStable)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildGraph(Graph, Noise, 2);
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 4);
+
+  /** removing the first factor of a timestamp keeps the number of the second one */
+  Graph.removeState("A", 1.0);
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 3);
+
+  const std::vector<libRSF::FactorID> Factors = GetFactors(Graph, "B", 1.0);
+  ASSERT_EQ(Factors.size(), 1u);
+  EXPECT_EQ(Factors.front().ID, libRSF::FactorType::Prior1);
+  EXPECT_EQ(Factors.front().Timestamp, libRSF::Tick(1.0));
+  EXPECT_EQ(Factors.front().Number, 1);
+
+  /** a new factor gets a new number */
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID("B", 1.0, 0), CreateMeasurement(1.0, 0.0), Noise);
+  EXPECT_EQ(GetFactors(Graph, "B", 1.0).size(), 2u);
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 4);
+}
+
+TEST(FactorGraphStructure, RemoveByTimestampAfterFirstIsGone)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildGraph(Graph, Noise, 2);
+
+  /** factor #0 at 1.0 is removed with its state, #1 remains */
+  Graph.removeState("A", 1.0);
+  ASSERT_EQ(GetFactors(Graph, "B", 1.0).size(), 1u);
+
+  /** the remaining factors of the timestamp are removed anyway */
+  Graph.removeFactor(libRSF::FactorType::Prior1, 1.0);
+  EXPECT_TRUE(GetFactors(Graph, "B", 1.0).empty());
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 2);
+
+  /** other timestamps are not touched */
+  EXPECT_EQ(GetFactors(Graph, "A", 0.0).size(), 1u);
+  EXPECT_EQ(GetFactors(Graph, "B", 0.0).size(), 1u);
+}
+
+TEST(FactorGraphStructure, WindowRemovesSlotsWithHoles)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildGraph(Graph, Noise, 4);
+
+  Graph.removeState("A", 0.0);
+  Graph.removeState("B", 2.0);
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 6);
+
+  /** everything up to 2.0 expires, independent of the holes */
+  Graph.removeFactorsOutsideWindow(libRSF::FactorType::Prior1, 1.0, 3.0);
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 2);
+  EXPECT_TRUE(GetFactors(Graph, "B", 0.0).empty());
+  EXPECT_TRUE(GetFactors(Graph, "A", 2.0).empty());
+  EXPECT_EQ(GetFactors(Graph, "A", 3.0).size(), 1u);
+  EXPECT_EQ(GetFactors(Graph, "B", 3.0).size(), 1u);
+
+  /** and the slot can be filled again */
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID("A", 1.0, 0), CreateMeasurement(1.0, 0.0), Noise);
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 3);
+  ASSERT_EQ(GetFactors(Graph, "A", 1.0).size(), 1u);
+  EXPECT_EQ(GetFactors(Graph, "A", 1.0).front().Number, 0);
+}
+
+TEST(FactorGraphStructure, BatchEqualsSingleFactors)
+{
+  std::vector<libRSF::GaussianDiagonal<1>> PriorNoise(3);
+  PriorNoise.at(0).setStdDevSharedDiagonal(1.0);
+  PriorNoise.at(1).setStdDevSharedDiagonal(2.0);
+  PriorNoise.at(2).setStdDevSharedDiagonal(0.5);
+  libRSF::GaussianDiagonal<1> BetweenNoise;
+  BetweenNoise.setStdDevSharedDiagonal(1.0);
+
+  const std::vector<libRSF::Data> Priors = {CreateMeasurement(0.0, 1.0), CreateMeasurement(0.0, 2.0), CreateMeasurement(0.0, 4.0)};
+  const std::vector<libRSF::Data> Betweens = {CreateMeasurement(1.0, 0.5), CreateMeasurement(1.0, 1.5)};
+
+  libRSF::StateList PriorStates, BetweenStates;
+  PriorStates.add("A", 0.0);
+  BetweenStates.add("A", 0.0);
+  BetweenStates.add("A", 1.0);
+
+  /** the same factors added at once and one by one */
+  libRSF::FactorGraph Batch, Single;
+  for (libRSF::FactorGraph *Graph : {&Batch, &Single})
+  {
+    Graph->addState("A", libRSF::DataType::Point1, 0.0);
+    Graph->addState("A", libRSF::DataType::Point1, 1.0);
+  }
+
+  Batch.addFactors<libRSF::FactorType::Prior1>(PriorStates, Priors, PriorNoise);
+  Batch.addFactors<libRSF::FactorType::BetweenValue1>(BetweenStates, Betweens, BetweenNoise);
+  for (size_t n = 0; n < Priors.size(); n++)
+  {
+    Single.addFactor<libRSF::FactorType::Prior1>(PriorStates, Priors.at(n), PriorNoise.at(n));
+  }
+  for (const libRSF::Data &Between : Betweens)
+  {
+    Single.addFactor<libRSF::FactorType::BetweenValue1>(BetweenStates, Between, BetweenNoise);
+  }
+
+  /** same structure */
+  for (const libRSF::FactorType Type : {libRSF::FactorType::Prior1, libRSF::FactorType::BetweenValue1})
+  {
+    EXPECT_EQ(Batch.countFactorsOfType(Type), Single.countFactorsOfType(Type));
+  }
+  for (const double Timestamp : {0.0, 1.0})
+  {
+    EXPECT_EQ(GetFactors(Batch, "A", Timestamp), GetFactors(Single, "A", Timestamp));
+  }
+
+  /** same solution */
+  for (libRSF::FactorGraph *Graph : {&Batch, &Single})
+  {
+    ceres::Solver::Options Options;
+    Options.minimizer_progress_to_stdout = false;
+    Options.num_threads = 1;
+    Graph->solve(Options);
+  }
+  for (const double Timestamp : {0.0, 1.0})
+  {
+    EXPECT_NEAR(Batch.getStateData().getElement("A", Timestamp).getMean()(0),
+                Single.getStateData().getElement("A", Timestamp).getMean()(0), 1e-9);
+  }
+
+  /** and the batch can be removed like single factors */
+  Batch.removeFactor(libRSF::FactorType::Prior1, 0.0);
+  Single.removeFactor(libRSF::FactorType::Prior1, 0.0);
+  EXPECT_EQ(Batch.countFactorsOfType(libRSF::FactorType::Prior1), 0);
+  EXPECT_EQ(GetFactors(Batch, "A", 0.0), GetFactors(Single, "A", 0.0));
+}
+
+// main provided by linking to gtest_main
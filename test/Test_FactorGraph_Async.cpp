@@ -0,0 +1,156 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_FactorGraph_Async.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks the asynchronous solver, staged modifications and the state snapshots.
+ * @copyright GNU Public License.
+ *
+ */
+
+#include "FactorGraph.h"
+#include "gtest/gtest.h"
+
+#define POSITION_STATE "Position"
+
+/** one 1D state with a prior at Value */
+static void BuildGraph(libRSF::FactorGraph &Graph, libRSF::GaussianDiagonal<1> &Noise, const double Value)
+{
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 0.0);
+  Graph.getStateData().getElement(POSITION_STATE, 0.0).setMean(libRSF::Vector1::Constant(10.0));
+
+  libRSF::Data Measurement(libRSF::DataType::Point1, 0.0);
+  Measurement.setMean(libRSF::Vector1::Constant(Value));
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), Measurement, Noise);
+}
+
+static double GetPosition(const libRSF::StateDataSet &States)
+{
+  libRSF::Data State;
+  EXPECT_TRUE(States.getElement(POSITION_STATE, 0.0, 0, State));
+  return State.getMean()(0);
+}
+
+static ceres::Solver::Options Options()
+{
+  ceres::Solver::Options SolverOptions;
+  SolverOptions.minimizer_progress_to_stdout = false;
+  SolverOptions.num_threads = 1;
+  return SolverOptions;
+}
+
+TEST(FactorGraphAsync, SameResultAsSyncSolve)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph SyncGraph, AsyncGraph;
+  BuildGraph(SyncGraph, Noise, 2.0);
+  BuildGraph(AsyncGraph, Noise, 2.0);
+
+  SyncGraph.solve(Options());
+  EXPECT_TRUE(AsyncGraph.solveAsync(Options()).get());
+  EXPECT_FALSE(AsyncGraph.isSolving());
+
+  EXPECT_NEAR(GetPosition(SyncGraph.getStateData()), 2.0, 1e-6);
+  EXPECT_NEAR(GetPosition(AsyncGraph.getStateData()), GetPosition(SyncGraph.getStateData()), 1e-9);
+}
+
+TEST(FactorGraphAsync, SyncSolveDoesNotPublish)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildGraph(Graph, Noise, 2.0);
+
+  Graph.solve(Options());
+  EXPECT_EQ(Graph.getStateSnapshot(), nullptr);
+
+  Graph.solveAsync(Options()).wait();
+  ASSERT_NE(Graph.getStateSnapshot(), nullptr);
+  EXPECT_NEAR(GetPosition(*Graph.getStateSnapshot()), 2.0, 1e-6);
+}
+
+TEST(FactorGraphAsync, StagedModificationsKeepOrder)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildGraph(Graph, Noise, 2.0);
+
+  std::vector<int> Order;
+  Graph.solveAsync(Options());
+  for (int n = 0; n < 3; n++)
+  {
+    Graph.stage([&Order, n](libRSF::FactorGraph &)
+    {
+      Order.push_back(n);
+    });
+  }
+
+  /** a second prior pulls the state to the mean of both measurements */
+  Graph.stage([&Noise](libRSF::FactorGraph &StagedGraph)
+  {
+    libRSF::Data Measurement(libRSF::DataType::Point1, 0.0);
+    Measurement.setMean(libRSF::Vector1::Constant(4.0));
+    StagedGraph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), Measurement, Noise);
+  });
+
+  Graph.waitForSolver();
+  EXPECT_EQ(Order, std::vector<int>({0, 1, 2}));
+  EXPECT_EQ(Graph.countFactorsOfType(libRSF::FactorType::Prior1), 2);
+
+  Graph.solveAsync(Options()).wait();
+  EXPECT_NEAR(GetPosition(Graph.getStateData()), 3.0, 1e-6);
+}
+
+TEST(FactorGraphAsync, SnapshotIsImmutable)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildGraph(Graph, Noise, 2.0);
+
+  Graph.solveAsync(Options()).wait();
+  const std::shared_ptr<const libRSF::StateDataSet> Snapshot = Graph.getStateSnapshot();
+  ASSERT_NE(Snapshot, nullptr);
+
+  /** later modifications of the graph do not change the published estimates */
+  Graph.getStateData().getElement(POSITION_STATE, 0.0).setMean(libRSF::Vector1::Constant(-5.0));
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 1.0);
+
+  EXPECT_NEAR(GetPosition(*Snapshot), 2.0, 1e-6);
+  EXPECT_EQ(Snapshot->countElements(POSITION_STATE), 1);
+
+  /** the next solve replaces the snapshot instead of modifying it */
+  Graph.solveAsync(Options()).wait();
+  EXPECT_NE(Graph.getStateSnapshot(), Snapshot);
+  EXPECT_NEAR(GetPosition(*Snapshot), 2.0, 1e-6);
+}
+
+// main provided by linking to gtest_main
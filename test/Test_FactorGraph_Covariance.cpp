@@ -0,0 +1,270 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_FactorGraph_Covariance.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Compares the recursive covariance of the newest states with the full computation.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "FactorGraph.h"
+#include "gtest/gtest.h"
+
+#define POSITION_STATE "Position"
+#define BIAS_STATE "Bias"
+
+static libRSF::Data CreateMeasurement(const double Timestamp, const double Value)
+{
+  libRSF::Data Measurement(libRSF::DataType::Point1, Timestamp);
+  Measurement.setMean(libRSF::Vector1::Constant(Value));
+  return Measurement;
+}
+
+static ceres::Solver::Options Options()
+{
+  ceres::Solver::Options SolverOptions;
+  SolverOptions.minimizer_progress_to_stdout = false;
+  SolverOptions.num_threads = 1;
+  return SolverOptions;
+}
+
+/** solve a chain epoch by epoch and compare the recursive covariance against the full one in each epoch */
+static void CompareCovariances(const bool WithBias)
+{
+  libRSF::GaussianDiagonal<1> Prior, RandomWalk, Measurement;
+  Prior.setStdDevSharedDiagonal(1.0);
+  RandomWalk.setStdDevSharedDiagonal(0.5);
+  Measurement.setStdDevSharedDiagonal(2.0);
+
+  libRSF::FactorGraph Graph;
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 0.0);
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Prior);
+
+  /** the bias is part of every epoch */
+  if (WithBias)
+  {
+    Graph.addState(BIAS_STATE, libRSF::DataType::Point1, 0.0);
+    Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(BIAS_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Prior);
+  }
+
+  for (int Epoch = 0; Epoch < 5; Epoch++)
+  {
+    const double Time = Epoch;
+    if (Epoch > 0)
+    {
+      Graph.addState(POSITION_STATE, libRSF::DataType::Point1, Time);
+      Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, Time - 1, 0),
+                                                           libRSF::StateID(POSITION_STATE, Time, 0),
+                                                           CreateMeasurement(Time, 1.0), RandomWalk);
+    }
+
+    std::vector<libRSF::StateID> States = {libRSF::StateID(POSITION_STATE, Time, 0)};
+    if (WithBias)
+    {
+      Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(BIAS_STATE, 0.0, 0),
+                                                           libRSF::StateID(POSITION_STATE, Time, 0),
+                                                           CreateMeasurement(Time, Time), Measurement);
+      States.emplace_back(libRSF::StateID(BIAS_STATE, 0.0, 0));
+    }
+
+    Graph.solve(Options());
+
+    ASSERT_TRUE(Graph.computeCovariancesRecursive(States));
+    std::vector<libRSF::Matrix> Recursive;
+    for (const libRSF::StateID &State : States)
+    {
+      Recursive.emplace_back(Graph.getStateData().getElement(State.ID, State.Timestamp, State.Number).getCovarianceMatrix());
+    }
+
+    ASSERT_TRUE(Graph.computeCovariances(States));
+    for (size_t n = 0; n < States.size(); n++)
+    {
+      const libRSF::Matrix Full = Graph.getStateData().getElement(States.at(n).ID, States.at(n).Timestamp, States.at(n).Number).getCovarianceMatrix();
+      EXPECT_TRUE(Recursive.at(n).isApprox(Full, 1e-6)) << "Epoch " << Epoch << " State " << States.at(n).ID << "\n"
+                                                        << Recursive.at(n) << "\n" << Full;
+    }
+  }
+}
+
+TEST(FactorGraphCovariance, RecursiveEqualsFull)
+{
+  CompareCovariances(false);
+}
+
+TEST(FactorGraphCovariance, RecursiveWithPersistentState)
+{
+  CompareCovariances(true);
+}
+
+/** compute the recursive covariance of States and compare it against the full one */
+static void ExpectRecursiveEqualsFull(libRSF::FactorGraph &Graph, const std::vector<libRSF::StateID> &States)
+{
+  ASSERT_TRUE(Graph.computeCovariancesRecursive(States));
+  std::vector<libRSF::Matrix> Recursive;
+  for (const libRSF::StateID &State : States)
+  {
+    Recursive.emplace_back(Graph.getStateData().getElement(State.ID, State.Timestamp, State.Number).getCovarianceMatrix());
+  }
+
+  ASSERT_TRUE(Graph.computeCovariances(States));
+  for (size_t n = 0; n < States.size(); n++)
+  {
+    const libRSF::Matrix Full = Graph.getStateData().getElement(States.at(n).ID, States.at(n).Timestamp, States.at(n).Number).getCovarianceMatrix();
+    EXPECT_TRUE(Recursive.at(n).isApprox(Full, 1e-6)) << Recursive.at(n) << "\n" << Full;
+  }
+}
+
+TEST(FactorGraphCovariance, SameStatesAfterNewFactor)
+{
+  libRSF::GaussianDiagonal<1> Prior, RandomWalk;
+  Prior.setStdDevSharedDiagonal(1.0);
+  RandomWalk.setStdDevSharedDiagonal(0.5);
+
+  libRSF::FactorGraph Graph;
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 0.0);
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Prior);
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 1.0);
+  Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, 0.0, 0),
+                                                       libRSF::StateID(POSITION_STATE, 1.0, 0),
+                                                       CreateMeasurement(1.0, 1.0), RandomWalk);
+  Graph.solve(Options());
+
+  const std::vector<libRSF::StateID> States = {libRSF::StateID(POSITION_STATE, 1.0, 0)};
+  ExpectRecursiveEqualsFull(Graph, States);
+
+  /** a factor between two calls with the same states has to be part of the result */
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 1.0, 0), CreateMeasurement(1.0, 1.0), Prior);
+  Graph.solve(Options());
+  ExpectRecursiveEqualsFull(Graph, States);
+}
+
+TEST(FactorGraphCovariance, RemovedStateResetsCache)
+{
+  libRSF::GaussianDiagonal<1> Prior, RandomWalk;
+  Prior.setStdDevSharedDiagonal(1.0);
+  RandomWalk.setStdDevSharedDiagonal(0.5);
+
+  libRSF::FactorGraph Graph;
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 0.0);
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Prior);
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 1.0);
+  Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, 0.0, 0),
+                                                       libRSF::StateID(POSITION_STATE, 1.0, 0),
+                                                       CreateMeasurement(1.0, 1.0), RandomWalk);
+  Graph.solve(Options());
+  ExpectRecursiveEqualsFull(Graph, {libRSF::StateID(POSITION_STATE, 1.0, 0)});
+
+  /** the cached state is gone, the next state is connected to an older one */
+  Graph.removeState(POSITION_STATE, 1.0);
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 2.0);
+  Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, 0.0, 0),
+                                                       libRSF::StateID(POSITION_STATE, 2.0, 0),
+                                                       CreateMeasurement(2.0, 2.0), RandomWalk);
+  Graph.solve(Options());
+  ExpectRecursiveEqualsFull(Graph, {libRSF::StateID(POSITION_STATE, 2.0, 0)});
+}
+
+/** random walk, the covariance between two states is the variance of the older one */
+static void BuildRandomWalk(libRSF::FactorGraph &Graph, const int Length)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 0.0);
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Noise);
+  for (int n = 1; n < Length; n++)
+  {
+    Graph.addState(POSITION_STATE, libRSF::DataType::Point1, n);
+    Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, n - 1, 0),
+                                                         libRSF::StateID(POSITION_STATE, n, 0),
+                                                         CreateMeasurement(n, 0.0), Noise);
+  }
+  Graph.solve(Options());
+}
+
+static double GetVariance(libRSF::FactorGraph &Graph, const double Timestamp)
+{
+  return Graph.getStateData().getElement(POSITION_STATE, Timestamp).getCovarianceMatrix()(0, 0);
+}
+
+TEST(FactorGraphCovariance, JointCovariance)
+{
+  libRSF::FactorGraph Graph;
+  BuildRandomWalk(Graph, 3);
+
+  const std::vector<libRSF::StateID> States = {libRSF::StateID(POSITION_STATE, 0.0, 0),
+                                               libRSF::StateID(POSITION_STATE, 1.0, 0),
+                                               libRSF::StateID(POSITION_STATE, 2.0, 0)};
+  libRSF::Matrix Joint;
+  ASSERT_TRUE(Graph.computeCovariances(States, Joint));
+
+  libRSF::Matrix Expected(3, 3);
+  Expected << 1, 1, 1,
+              1, 2, 2,
+              1, 2, 3;
+  EXPECT_TRUE(Joint.isApprox(Expected, 1e-6)) << Joint;
+
+  /** the marginals are the same as with a separate computation for each state */
+  std::vector<double> Marginals;
+  for (const libRSF::StateID &State : States)
+  {
+    Marginals.push_back(GetVariance(Graph, State.Timestamp));
+  }
+  for (size_t n = 0; n < States.size(); n++)
+  {
+    ASSERT_TRUE(Graph.computeCovariance(POSITION_STATE, States.at(n).Timestamp));
+    EXPECT_NEAR(GetVariance(Graph, States.at(n).Timestamp), Marginals.at(n), 1e-6);
+    EXPECT_NEAR(Marginals.at(n), Expected(n, n), 1e-6);
+  }
+}
+
+TEST(FactorGraphCovariance, JointCovarianceWithRepeatedStates)
+{
+  libRSF::FactorGraph Graph;
+  BuildRandomWalk(Graph, 3);
+
+  /** repeated states are part of the joint covariance only once, in the order of their first appearance */
+  const std::vector<libRSF::StateID> States = {libRSF::StateID(POSITION_STATE, 2.0, 0),
+                                               libRSF::StateID(POSITION_STATE, 0.0, 0),
+                                               libRSF::StateID(POSITION_STATE, 2.0, 0),
+                                               libRSF::StateID(POSITION_STATE, 0.0, 0)};
+  libRSF::Matrix Joint;
+  ASSERT_TRUE(Graph.computeCovariances(States, Joint));
+
+  libRSF::Matrix Expected(2, 2);
+  Expected << 3, 1,
+              1, 1;
+  EXPECT_TRUE(Joint.isApprox(Expected, 1e-6)) << Joint;
+  EXPECT_NEAR(GetVariance(Graph, 2.0), 3.0, 1e-6);
+  EXPECT_NEAR(GetVariance(Graph, 0.0), 1.0, 1e-6);
+
+  /** without joint covariance only the marginals are written */
+  ASSERT_TRUE(Graph.computeCovariances({libRSF::StateID(POSITION_STATE, 1.0, 0), libRSF::StateID(POSITION_STATE, 1.0, 0)}));
+  EXPECT_NEAR(GetVariance(Graph, 1.0), 2.0, 1e-6);
+}
+
+// main provided by linking to gtest_main
@@ -0,0 +1,232 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_FactorGraph_Incremental.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks which states are held constant and which solves are skipped by the incremental modes.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "FactorGraph.h"
+#include "gtest/gtest.h"
+
+#define POSITION_STATE "Position"
+
+static libRSF::Data CreateMeasurement(const double Timestamp, const double Value)
+{
+  libRSF::Data Measurement(libRSF::DataType::Point1, Timestamp);
+  Measurement.setMean(libRSF::Vector1::Constant(Value));
+  return Measurement;
+}
+
+/** a chain of 1D states with a prior at zero for each state and zero between them, all states start at Initial */
+static void BuildChain(libRSF::FactorGraph &Graph, libRSF::GaussianDiagonal<1> &Noise, const int Length, const double Initial)
+{
+  for (int n = 0; n < Length; n++)
+  {
+    const double Timestamp = n;
+    Graph.addState(POSITION_STATE, libRSF::DataType::Point1, Timestamp);
+    Graph.getStateData().getElement(POSITION_STATE, Timestamp).setMean(libRSF::Vector1::Constant(Initial));
+    Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, Timestamp, 0), CreateMeasurement(Timestamp, 0.0), Noise);
+
+    if (n > 0)
+    {
+      Graph.addFactor<libRSF::FactorType::BetweenValue1>(libRSF::StateID(POSITION_STATE, Timestamp - 1, 0),
+                                                           libRSF::StateID(POSITION_STATE, Timestamp, 0),
+                                                           CreateMeasurement(Timestamp, 0.0), Noise);
+    }
+  }
+}
+
+static double GetPosition(libRSF::FactorGraph &Graph, const double Timestamp, const int Number = 0)
+{
+  return Graph.getStateData().getElement(POSITION_STATE, Timestamp, Number).getMean()(0);
+}
+
+static ceres::Solver::Options Options()
+{
+  ceres::Solver::Options SolverOptions;
+  SolverOptions.minimizer_progress_to_stdout = false;
+  SolverOptions.num_threads = 1;
+  return SolverOptions;
+}
+
+TEST(FactorGraphIncremental, UserConstantStatesAreKept)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  BuildChain(Graph, Noise, 3, 10.0);
+  Graph.setConstant(POSITION_STATE, 0.0);
+
+  /** the active window holds the first two states constant */
+  Graph.setIncrementalMode(true, 0.5);
+  Graph.solve(Options());
+  EXPECT_DOUBLE_EQ(GetPosition(Graph, 0.0), 10.0);
+  EXPECT_DOUBLE_EQ(GetPosition(Graph, 1.0), 10.0);
+
+  /** only the state of the window is released */
+  Graph.setIncrementalMode(false);
+  Graph.solve(Options());
+  EXPECT_DOUBLE_EQ(GetPosition(Graph, 0.0), 10.0);
+  EXPECT_LT(GetPosition(Graph, 1.0), 10.0);
+}
+
+TEST(FactorGraphIncremental, ErrorModelChangesAreSolved)
+{
+  libRSF::GaussianDiagonal<1> Noise, Tight;
+  Noise.setStdDevSharedDiagonal(1.0);
+  Tight.setStdDevSharedDiagonal(0.1);
+
+  libRSF::FactorGraph Graph;
+  Graph.addState(POSITION_STATE, libRSF::DataType::Point1, 0.0);
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Noise);
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 4.0), Noise);
+
+  Graph.setIncrementalMode(true, std::numeric_limits<double>::infinity(), true);
+  Graph.solve(Options());
+  EXPECT_NEAR(GetPosition(Graph, 0.0), 2.0, 1e-6);
+
+  /** the second prior dominates after tuning */
+  Graph.setNewErrorModel(libRSF::FactorType::Prior1, 0.0, 1, Tight);
+  Graph.solve(Options());
+  EXPECT_NEAR(GetPosition(Graph, 0.0), 400.0 / 101.0, 1e-6);
+}
+
+TEST(FactorGraphIncremental, UnchangedSolvesAreOnlySkippedOnRequest)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  /** a re-initialized state is solved again by default */
+  libRSF::FactorGraph Graph;
+  BuildChain(Graph, Noise, 2, 10.0);
+  Graph.setIncrementalMode(true);
+  Graph.solve(Options());
+  Graph.getStateData().getElement(POSITION_STATE, 1.0).setMean(libRSF::Vector1::Constant(7.0));
+  Graph.solve(Options());
+  EXPECT_NEAR(GetPosition(Graph, 1.0), 0.0, 1e-6);
+
+  /** direct writes are not detected, if skipping is requested */
+  libRSF::FactorGraph SkippingGraph;
+  BuildChain(SkippingGraph, Noise, 2, 10.0);
+  SkippingGraph.setIncrementalMode(true, std::numeric_limits<double>::infinity(), true);
+  SkippingGraph.solve(Options());
+  SkippingGraph.getStateData().getElement(POSITION_STATE, 1.0).setMean(libRSF::Vector1::Constant(7.0));
+  SkippingGraph.solve(Options());
+  EXPECT_DOUBLE_EQ(GetPosition(SkippingGraph, 1.0), 7.0);
+}
+
+TEST(FactorGraphIncremental, SmootherKeepsUserConstantStates)
+{
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph Graph;
+  Graph.setSmootherMode(true);
+  BuildChain(Graph, Noise, 2, 10.0);
+  Graph.setConstant(POSITION_STATE, 0.0);
+  Graph.solve(Options());
+  EXPECT_DOUBLE_EQ(GetPosition(Graph, 0.0), 10.0);
+
+  /** the new factor connects the constant state, which is not released by the update */
+  Graph.addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, 0.0, 0), CreateMeasurement(0.0, 0.0), Noise);
+  Graph.solve(Options());
+  EXPECT_DOUBLE_EQ(GetPosition(Graph, 0.0), 10.0);
+
+  /** leaving the smoother releases only its own states */
+  Graph.setSmootherMode(false);
+  Graph.getStateData().getElement(POSITION_STATE, 1.0).setMean(libRSF::Vector1::Constant(10.0));
+  Graph.solve(Options());
+  EXPECT_DOUBLE_EQ(GetPosition(Graph, 0.0), 10.0);
+  EXPECT_LT(GetPosition(Graph, 1.0), 10.0);
+}
+
+/** build the same chain with and without smoother, add a prior to the newest state and compare against the batch solution */
+static void CompareSmootherAndBatch(const int MaxPropagationSteps, std::vector<double> &Smoother, std::vector<double> &Batch)
+{
+  const int Length = 5;
+  libRSF::GaussianDiagonal<1> Noise;
+  Noise.setStdDevSharedDiagonal(1.0);
+
+  libRSF::FactorGraph SmootherGraph, BatchGraph;
+  SmootherGraph.setSmootherMode(true, 0.01, MaxPropagationSteps);
+  BuildChain(SmootherGraph, Noise, Length, 0.0);
+  BuildChain(BatchGraph, Noise, Length, 0.0);
+  SmootherGraph.solve(Options());
+
+  /** the new factor pulls the whole chain */
+  for (libRSF::FactorGraph *Graph : {&SmootherGraph, &BatchGraph})
+  {
+    Graph->addFactor<libRSF::FactorType::Prior1>(libRSF::StateID(POSITION_STATE, Length - 1, 0), CreateMeasurement(Length - 1, 10.0), Noise);
+    Graph->solve(Options());
+  }
+
+  Smoother.clear();
+  Batch.clear();
+  for (int n = 0; n < Length; n++)
+  {
+    Smoother.push_back(GetPosition(SmootherGraph, n));
+    Batch.push_back(GetPosition(BatchGraph, n));
+  }
+}
+
+TEST(FactorGraphIncremental, SmootherMatchesBatch)
+{
+  /** the propagation reaches all states of the chain, so the result is the batch solution */
+  std::vector<double> Smoother, Batch;
+  CompareSmootherAndBatch(5, Smoother, Batch);
+  for (size_t n = 0; n < Batch.size(); n++)
+  {
+    EXPECT_NEAR(Smoother.at(n), Batch.at(n), 1e-6) << "State " << n;
+  }
+
+  /** the oldest state has to move as well */
+  EXPECT_GT(Smoother.front(), 0.01);
+}
+
+TEST(FactorGraphIncremental, SmootherWithoutPropagationIsApproximate)
+{
+  /** without propagation, only the state of the new factor is updated against its fixed neighbor */
+  std::vector<double> Smoother, Batch;
+  CompareSmootherAndBatch(0, Smoother, Batch);
+  EXPECT_NEAR(Smoother.back(), 10.0 / 3.0, 1e-6);
+  for (size_t n = 0; n + 1 < Batch.size(); n++)
+  {
+    EXPECT_DOUBLE_EQ(Smoother.at(n), 0.0) << "State " << n;
+    EXPECT_GT(Batch.at(n), 0.01) << "State " << n;
+  }
+
+  /** the error is bounded by the batch update of the old states */
+  for (size_t n = 0; n < Batch.size(); n++)
+  {
+    EXPECT_LE(std::abs(Smoother.at(n) - Batch.at(n)), std::abs(Batch.at(n)) + 1e-6) << "State " << n;
+  }
+}
+
+// main provided by linking to gtest_main
@@ -0,0 +1,261 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_FileAccess.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks that all dataset readers and writers produce the same measurements.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "FileAccess.h"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+static const std::string InputFile = "datasets/Indoor UWB/Indoor_UWB_Input.txt";
+
+/** unique file in the temporary directory, that is removed at the end of the test */
+class TemporaryFile
+{
+  public:
+    explicit TemporaryFile(const std::string &Name) : Path((std::filesystem::temp_directory_path() / Name).string())
+    {}
+
+    ~TemporaryFile()
+    {
+      std::error_code Error;
+      std::filesystem::remove(Path, Error);
+    }
+
+    const std::string Path;
+};
+
+static int CountElements(const libRSF::SensorDataSet &Set)
+{
+  int Count = 0;
+  for (const libRSF::DataType Type : Set.getKeysAll())
+  {
+    Count += Set.countElements(Type);
+  }
+  return Count;
+}
+
+/** same types, same order and bitwise identical values */
+static void ExpectEqual(const libRSF::SensorDataSet &Expected, const libRSF::SensorDataSet &Actual)
+{
+  ASSERT_EQ(Expected.getKeysAll(), Actual.getKeysAll());
+
+  for (const libRSF::DataType Type : Expected.getKeysAll())
+  {
+    const std::vector<libRSF::Data> ExpectedElements = Expected.getElementsOfID(Type);
+    const std::vector<libRSF::Data> ActualElements = Actual.getElementsOfID(Type);
+    ASSERT_EQ(ExpectedElements.size(), ActualElements.size()) << "Type: " << Type;
+
+    for (size_t n = 0; n < ExpectedElements.size(); n++)
+    {
+      const libRSF::Data &ExpectedElement = ExpectedElements.at(n);
+      const libRSF::Data &ActualElement = ActualElements.at(n);
+      ASSERT_EQ(ExpectedElement.getType(), ActualElement.getType());
+      ASSERT_EQ(ExpectedElement.getBufferSize(), ActualElement.getBufferSize());
+      for (libRSF::Index i = 0; i < ExpectedElement.getBufferSize(); i++)
+      {
+        EXPECT_EQ(ExpectedElement.getBufferPointer()[i], ActualElement.getBufferPointer()[i]) << "Type: " << Type << " Element: " << n;
+      }
+    }
+  }
+}
+
+TEST(FileAccess, BinaryRoundTrip)
+{
+  libRSF::SensorDataSet Ascii;
+  libRSF::ReadDataFromFile(InputFile, Ascii);
+  ASSERT_EQ(CountElements(Ascii), 466);
+
+  TemporaryFile Binary("Test_FileAccess_RoundTrip.rsfb");
+  ASSERT_TRUE(libRSF::WriteDataToBinaryFile(Binary.Path, Ascii));
+
+  libRSF::SensorDataSet Read;
+  ASSERT_TRUE(libRSF::ReadDataFromBinaryFile(Binary.Path, Read));
+  ExpectEqual(Ascii, Read);
+}
+
+TEST(FileAccess, ConvertToBinary)
+{
+  libRSF::SensorDataSet Ascii;
+  libRSF::ReadDataFromFile(InputFile, Ascii);
+
+  TemporaryFile Binary("Test_FileAccess_Convert.rsfb");
+  ASSERT_TRUE(libRSF::ConvertDataFileToBinary(InputFile, Binary.Path));
+
+  libRSF::SensorDataSet Read;
+  ASSERT_TRUE(libRSF::ReadDataFromBinaryFile(Binary.Path, Read));
+  ExpectEqual(Ascii, Read);
+}
+
+/** overwrite 8 bytes of a file */
+static void PatchUInt64(const std::string &Path, const std::streamoff Offset, const uint64_t Value)
+{
+  std::fstream File(Path, std::ios::in | std::ios::out | std::ios::binary);
+  File.seekp(Offset);
+  File.write(reinterpret_cast<const char*>(&Value), sizeof(Value));
+}
+
+TEST(FileAccess, BinaryRejectsCorruptedFiles)
+{
+  libRSF::SensorDataSet Ascii;
+  libRSF::ReadDataFromFile(InputFile, Ascii);
+
+  TemporaryFile Binary("Test_FileAccess_Corrupted.rsfb");
+  ASSERT_TRUE(libRSF::WriteDataToBinaryFile(Binary.Path, Ascii));
+  const uintmax_t Size = std::filesystem::file_size(Binary.Path);
+
+  /** every truncation has to be detected */
+  TemporaryFile Truncated("Test_FileAccess_Truncated.rsfb");
+  for (const uintmax_t Length : {uintmax_t(20), uintmax_t(24), uintmax_t(40), Size / 2, Size - 8, Size - 1})
+  {
+    std::filesystem::copy_file(Binary.Path, Truncated.Path, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(Truncated.Path, Length);
+
+    libRSF::SensorDataSet Read;
+    EXPECT_FALSE(libRSF::ReadDataFromBinaryFile(Truncated.Path, Read)) << "Length " << Length;
+  }
+
+  /** sizes that overflow, if they are added or multiplied naively; the header has 16 bytes, followed by the name length */
+  const uint64_t NameLength = libRSF::GlobalDataConfig.getName(Ascii.begin()->first).size();
+  const std::streamoff MeasurementNumberOffset = 16 + 8 + static_cast<std::streamoff>((NameLength + 7) / 8 * 8) + 8;
+  for (const auto &Patch : {std::make_pair(std::streamoff(16), std::numeric_limits<uint64_t>::max()),
+                            std::make_pair(std::streamoff(16), std::numeric_limits<uint64_t>::max() - 3),
+                            std::make_pair(MeasurementNumberOffset, std::numeric_limits<uint64_t>::max()),
+                            std::make_pair(MeasurementNumberOffset, uint64_t(1) << 61)})
+  {
+    std::filesystem::copy_file(Binary.Path, Truncated.Path, std::filesystem::copy_options::overwrite_existing);
+    PatchUInt64(Truncated.Path, Patch.first, Patch.second);
+
+    libRSF::SensorDataSet Read;
+    EXPECT_FALSE(libRSF::ReadDataFromBinaryFile(Truncated.Path, Read)) << "Offset " << Patch.first << " Value " << Patch.second;
+  }
+}
+
+TEST(FileAccess, BinaryRejectsOtherFiles)
+{
+  libRSF::SensorDataSet Read;
+  EXPECT_FALSE(libRSF::ReadDataFromBinaryFile(InputFile, Read));
+  EXPECT_FALSE(libRSF::ReadDataFromBinaryFile("does_not_exist.rsfb", Read));
+  EXPECT_EQ(CountElements(Read), 0);
+}
+
+TEST(FileAccess, ParseLineLikeStrtod)
+{
+  /** different notations of the same kind of numbers */
+  for (const std::string Line : {"range2 0.127943992614746 2.95522014829822 0.01 -0.02 -0.01 105",
+                                 "range2 1.5e-1 2.955E+00 1E-2 -2.5e+02 -0.0 105  ",
+                                 "range2\t12\t-3.\t.5\t1e0\t0\t7"})
+  {
+    const libRSF::Data Measurement(Line);
+    ASSERT_EQ(Measurement.getType(), libRSF::DataType::Range2) << Line;
+
+    std::istringstream Stream(Line);
+    std::string Token;
+    Stream >> Token;
+
+    libRSF::Index i = 0;
+    while (Stream >> Token)
+    {
+      ASSERT_LT(i, Measurement.getBufferSize()) << Line;
+      EXPECT_EQ(Measurement.getBufferPointer()[i], std::strtod(Token.c_str(), nullptr)) << Line << " Token: " << Token;
+      i++;
+    }
+    EXPECT_EQ(i, Measurement.getBufferSize()) << Line;
+  }
+}
+
+TEST(FileAccess, ParallelKeepsFileOrder)
+{
+  libRSF::SensorDataSet Sequential;
+  libRSF::ReadDataFromFile(InputFile, Sequential);
+
+  /** the chunks have to be merged in file order, independent of the number of threads and chunks */
+  for (const int Threads : {1, 2, 3, 8, 64})
+  {
+    for (const size_t ChunkSize : {size_t(1), size_t(100), size_t(4096), size_t(1 << 20)})
+    {
+      libRSF::SensorDataSet Parallel;
+      libRSF::ReadDataFromFileParallel(InputFile, Parallel, Threads, ChunkSize);
+      ExpectEqual(Sequential, Parallel);
+    }
+  }
+}
+
+TEST(FileAccess, ParallelKeepsOrderOfEqualTimestamps)
+{
+  /** measurements with the same timestamp have to keep their order in the file */
+  TemporaryFile Input("Test_FileAccess_Equal.txt");
+  {
+    std::ofstream File(Input.Path);
+    for (int n = 0; n < 200; n++)
+    {
+      File << "range2 " << n / 10 << " " << n << " 0.1 0 0 " << n << "\n";
+    }
+  }
+
+  libRSF::SensorDataSet Sequential;
+  libRSF::ReadDataFromFile(Input.Path, Sequential);
+  ASSERT_EQ(CountElements(Sequential), 200);
+
+  /** small chunks split the equal timestamps between several runs */
+  libRSF::SensorDataSet Parallel;
+  libRSF::ReadDataFromFileParallel(Input.Path, Parallel, 7, 64);
+  ExpectEqual(Sequential, Parallel);
+
+  const std::vector<libRSF::Data> Elements = Parallel.getElementsOfID(libRSF::DataType::Range2);
+  for (size_t n = 0; n < Elements.size(); n++)
+  {
+    EXPECT_DOUBLE_EQ(Elements.at(n).getMean()(0), static_cast<double>(n));
+  }
+}
+
+TEST(FileAccess, ParallelFilesKeepTheirOrder)
+{
+  libRSF::SensorDataSet Sequential;
+  libRSF::ReadDataFromFile(InputFile, Sequential);
+
+  const std::vector<std::string> Files = {InputFile, InputFile, InputFile};
+
+  std::vector<libRSF::SensorDataSet> Parallel;
+  libRSF::ReadDataFromFilesParallel(Files, Parallel, 4, 512);
+  ASSERT_EQ(Parallel.size(), Files.size());
+  for (const libRSF::SensorDataSet &Set : Parallel)
+  {
+    ExpectEqual(Sequential, Set);
+  }
+}
+
+// main provided by linking to gtest_main
@@ -0,0 +1,190 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_LocalCostEvaluator.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Compares the local cost evaluation of one state against ceres::Problem::Evaluate.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "LocalCostEvaluator.h"
+#include "LocalParametrization.h"
+#include "NormalizeAngle.h"
+#include "VectorMath.h"
+#include "gtest/gtest.h"
+
+/** non-linear measurement of a state, scaled to unit variance */
+template <int Dim>
+struct RangeCost
+{
+  explicit RangeCost(const double Range) : _Range(Range) {}
+
+  template <typename T>
+  bool operator()(const T* const State, T* Residual) const
+  {
+    T SquaredNorm = T(1.0);
+    for (int n = 0; n < Dim; n++)
+    {
+      SquaredNorm += State[n] * State[n];
+    }
+    Residual[0] = sqrt(SquaredNorm) - T(_Range);
+    return true;
+  }
+
+  const double _Range;
+};
+
+/** difference of two states */
+template <int Dim>
+struct BetweenCost
+{
+  template <typename T>
+  bool operator()(const T* const Old, const T* const New, T* Residual) const
+  {
+    for (int n = 0; n < Dim; n++)
+    {
+      Residual[n] = New[n] - Old[n] - T(0.5);
+    }
+    return true;
+  }
+};
+
+/** angular difference to a constant */
+struct AngleCost
+{
+  template <typename T>
+  bool operator()(const T* const Angle, T* Residual) const
+  {
+    Residual[0] = libRSF::NormalizeAngle(Angle[0] - T(3.0));
+    return true;
+  }
+};
+
+static ceres::Problem::Options ProblemOptions()
+{
+  ceres::Problem::Options Options;
+  Options.loss_function_ownership = ceres::DO_NOT_TAKE_OWNERSHIP;
+  return Options;
+}
+
+/** the evaluator at the current value of the state has to match the evaluation of the whole problem by ceres */
+template <int Dim>
+static void ExpectEqualToCeres(ceres::Problem &Graph, double* const StatePointer)
+{
+  libRSF::LocalCostEvaluator<Dim> Evaluator(Graph, StatePointer);
+  const libRSF::VectorStatic<Dim> Point = Eigen::Map<const libRSF::VectorStatic<Dim>>(StatePointer);
+
+  double Cost;
+  libRSF::VectorStatic<Dim> Gradient;
+  libRSF::MatrixStatic<Dim, Dim> Hessian;
+  ASSERT_TRUE(Evaluator.evaluate(Point, Cost, &Gradient, &Hessian));
+
+  ceres::Problem::EvaluateOptions Options;
+  Options.apply_loss_function = true;
+  Options.num_threads = 1;
+  Options.parameter_blocks = {StatePointer};
+
+  double CeresCost;
+  std::vector<double> CeresGradient;
+  ceres::CRSMatrix JacobianCRS;
+  ASSERT_TRUE(Graph.Evaluate(Options, &CeresCost, nullptr, &CeresGradient, &JacobianCRS));
+
+  libRSF::Matrix Jacobian;
+  libRSF::CRSToMatrix(JacobianCRS, Jacobian);
+  const libRSF::Matrix CeresHessian = Jacobian.transpose() * Jacobian;
+
+  EXPECT_NEAR(Cost, CeresCost, 1e-9);
+  ASSERT_EQ(static_cast<int>(CeresGradient.size()), Dim);
+  for (int n = 0; n < Dim; n++)
+  {
+    EXPECT_NEAR(Gradient(n), CeresGradient.at(n), 1e-9) << "Dimension " << n;
+  }
+  EXPECT_TRUE(Hessian.isApprox(CeresHessian, 1e-9)) << Hessian << "\n" << CeresHessian;
+}
+
+/** a state with two non-linear measurements and a between factor to a second state */
+static void TestPoint2(ceres::LossFunction* const Loss)
+{
+  double State[2] = {1.0, 2.0};
+  double Other[2] = {0.3, -0.4};
+
+  ceres::Problem Graph(ProblemOptions());
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<RangeCost<2>, 1, 2>(new RangeCost<2>(1.0)), Loss, State);
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<RangeCost<2>, 1, 2>(new RangeCost<2>(5.0)), Loss, State);
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<BetweenCost<2>, 2, 2, 2>(new BetweenCost<2>()), Loss, Other, State);
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<RangeCost<2>, 1, 2>(new RangeCost<2>(2.0)), nullptr, Other);
+
+  ExpectEqualToCeres<2>(Graph, State);
+}
+
+TEST(LocalCostEvaluator, WithoutLoss)
+{
+  TestPoint2(nullptr);
+}
+
+TEST(LocalCostEvaluator, WithCauchyLoss)
+{
+  ceres::CauchyLoss Loss(0.5);
+  TestPoint2(&Loss);
+}
+
+TEST(LocalCostEvaluator, WithTolerantLoss)
+{
+  /** the second derivative of this loss is positive, so the curvature correction is applied */
+  ceres::TolerantLoss Loss(0.5, 0.2);
+  TestPoint2(&Loss);
+}
+
+TEST(LocalCostEvaluator, AngleState)
+{
+  double Angle = 3.0 - 2.0 * M_PI + 0.7;
+  double Other = 0.1;
+
+  ceres::HuberLoss Loss(0.5);
+  ceres::Problem Graph(ProblemOptions());
+  Graph.AddParameterBlock(&Angle, 1, libRSF::AngleLocalParameterization::Create());
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<AngleCost, 1, 1>(new AngleCost()), &Loss, &Angle);
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<BetweenCost<1>, 1, 1, 1>(new BetweenCost<1>()), nullptr, &Other, &Angle);
+
+  ExpectEqualToCeres<1>(Graph, &Angle);
+}
+
+TEST(LocalCostEvaluator, RejectsSmallerLocalSize)
+{
+  double Circle[2] = {1.0, 0.0};
+
+  ceres::Problem Graph(ProblemOptions());
+  Graph.AddParameterBlock(Circle, 2, libRSF::UnitCircleLocalParameterization::Create());
+  Graph.AddResidualBlock(new ceres::AutoDiffCostFunction<RangeCost<2>, 1, 2>(new RangeCost<2>(1.0)), nullptr, Circle);
+
+  libRSF::LocalCostEvaluator<2> Evaluator(Graph, Circle);
+  double Cost;
+  EXPECT_FALSE(Evaluator.evaluate(libRSF::Vector2(1.0, 0.0), Cost));
+  EXPECT_TRUE(std::isnan(Cost));
+}
+
+// main provided by linking to gtest_main
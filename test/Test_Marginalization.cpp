@@ -0,0 +1,134 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_Marginalization.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Compares the sparse marginalization against the dense reference implementation.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "Marginalization.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+/** convert a dense matrix into the CRS format of ceres */
+static ceres::CRSMatrix DenseToCRS(const libRSF::Matrix &Dense)
+{
+  ceres::CRSMatrix CRS;
+  CRS.num_rows = Dense.rows();
+  CRS.num_cols = Dense.cols();
+  CRS.rows.push_back(0);
+  for (int Row = 0; Row < Dense.rows(); Row++)
+  {
+    for (int Col = 0; Col < Dense.cols(); Col++)
+    {
+      if (Dense(Row, Col) != 0.0)
+      {
+        CRS.cols.push_back(Col);
+        CRS.values.push_back(Dense(Row, Col));
+      }
+    }
+    CRS.rows.push_back(static_cast<int>(CRS.values.size()));
+  }
+  return CRS;
+}
+
+/** random Jacobian where each factor connects a subset of the state blocks */
+static libRSF::Matrix CreateJacobian(const std::vector<int> &BlockSizes, const std::vector<std::vector<int>> &Factors, const int FactorSize)
+{
+  std::vector<int> BlockOffsets;
+  int Cols = 0;
+  for (const int Size : BlockSizes)
+  {
+    BlockOffsets.push_back(Cols);
+    Cols += Size;
+  }
+
+  std::srand(42);
+  libRSF::Matrix Jacobian = libRSF::Matrix::Zero(Factors.size() * FactorSize, Cols);
+  for (size_t Factor = 0; Factor < Factors.size(); Factor++)
+  {
+    for (const int Block : Factors.at(Factor))
+    {
+      Jacobian.block(Factor * FactorSize, BlockOffsets.at(Block), FactorSize, BlockSizes.at(Block)) = libRSF::Matrix::Random(FactorSize, BlockSizes.at(Block));
+    }
+  }
+  return Jacobian;
+}
+
+/** the square root of the result is not unique, so the information and the information vector are compared */
+static void CompareWithDense(const std::vector<int> &BlockSizes, const int MarginalBlocks,
+                             const std::vector<std::vector<int>> &Factors, const double Inflation)
+{
+  const libRSF::Matrix Jacobian = CreateJacobian(BlockSizes, Factors, 3);
+  const libRSF::Vector Residual = libRSF::Vector::Random(Jacobian.rows());
+
+  const std::vector<int> MarginalBlockSizes(BlockSizes.begin(), BlockSizes.begin() + MarginalBlocks);
+  const int MarginalSize = std::accumulate(MarginalBlockSizes.begin(), MarginalBlockSizes.end(), 0);
+
+  libRSF::Vector ResidualDense, ResidualSparse;
+  libRSF::Matrix JacobianDense, JacobianSparse;
+  libRSF::Marginalize(Residual, Jacobian, ResidualDense, JacobianDense, MarginalSize, Inflation);
+  libRSF::MarginalizeSparse(Residual, DenseToCRS(Jacobian), ResidualSparse, JacobianSparse, MarginalBlockSizes, Inflation);
+
+  ASSERT_EQ(JacobianSparse.cols(), Jacobian.cols() - MarginalSize);
+  ASSERT_EQ(JacobianSparse.cols(), JacobianDense.cols());
+
+  const libRSF::Matrix InformationDense = JacobianDense.transpose() * JacobianDense;
+  const libRSF::Matrix InformationSparse = JacobianSparse.transpose() * JacobianSparse;
+  EXPECT_TRUE(InformationSparse.isApprox(InformationDense, 1e-8)) << InformationSparse << "\n\n" << InformationDense;
+
+  const libRSF::Vector VectorDense = JacobianDense.transpose() * ResidualDense;
+  const libRSF::Vector VectorSparse = JacobianSparse.transpose() * ResidualSparse;
+  EXPECT_TRUE(VectorSparse.isApprox(VectorDense, 1e-8)) << VectorSparse.transpose() << "\n" << VectorDense.transpose();
+}
+
+TEST(Marginalization, ChainEqualsDense)
+{
+  /** three marginalized blocks of a chain, connected to two remaining blocks */
+  CompareWithDense({2, 1, 3, 2, 2}, 3, {{0}, {0, 1}, {1, 2}, {2, 3}, {3, 4}, {4}}, 1.0);
+}
+
+TEST(Marginalization, IndependentGroupsEqualDense)
+{
+  /** the marginalized blocks 0 and 1 are only connected through the remaining block 3 */
+  CompareWithDense({2, 2, 1, 2}, 3, {{0}, {0, 3}, {1}, {1, 3}, {2}, {2, 3}, {3}}, 1.0);
+}
+
+TEST(Marginalization, InflationEqualsDense)
+{
+  CompareWithDense({2, 1, 3, 2, 2}, 3, {{0}, {0, 1}, {1, 2}, {2, 3}, {3, 4}, {4}}, 2.0);
+}
+
+TEST(Marginalization, RankDeficientEqualsDense)
+{
+  /** the first block has four dimensions, but is observed by a single factor with three */
+  CompareWithDense({4, 2, 2}, 2, {{0, 1}, {1, 2}, {2}}, 1.0);
+}
+
+// main provided by linking to gtest_main
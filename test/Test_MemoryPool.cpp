@@ -0,0 +1,199 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_MemoryPool.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks allocation, reuse and thread-safety of the memory pools.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "MemoryPool.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <thread>
+
+struct SmallObject : public libRSF::PoolAllocated
+{
+  double Values[3];
+};
+
+struct LargeObject : public libRSF::PoolAllocated
+{
+  double Values[2 * libRSF::MemoryPool::MaxObjectSize];
+};
+
+struct alignas(64) AlignedObject : public libRSF::PoolAllocated
+{
+  double Value;
+};
+
+class Base
+{
+  public:
+    virtual ~Base() = default;
+    double Value = 0.0;
+};
+
+static bool IsAligned(const void* Pointer, const size_t Alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(Pointer) % Alignment == 0;
+}
+
+TEST(MemoryPool, AllocateAndReuse)
+{
+  libRSF::MemoryPool Pool(24, 4);
+  EXPECT_GE(Pool.getBlockSize(), 24u);
+  EXPECT_EQ(Pool.getBlockSize() % libRSF::MemoryPool::Granularity, 0u);
+
+  /** more blocks than one chunk holds, all distinct and aligned */
+  std::vector<void*> Blocks;
+  for (int n = 0; n < 10; n++)
+  {
+    Blocks.push_back(Pool.allocate());
+    ASSERT_NE(Blocks.back(), nullptr);
+    EXPECT_TRUE(IsAligned(Blocks.back(), libRSF::MemoryPool::Granularity));
+  }
+  EXPECT_EQ(std::set<void*>(Blocks.begin(), Blocks.end()).size(), Blocks.size());
+
+  /** blocks must not overlap */
+  std::sort(Blocks.begin(), Blocks.end());
+  for (size_t n = 1; n < Blocks.size(); n++)
+  {
+    EXPECT_GE(static_cast<char*>(Blocks.at(n)) - static_cast<char*>(Blocks.at(n - 1)), static_cast<std::ptrdiff_t>(Pool.getBlockSize()));
+  }
+
+  /** a freed block is reused by the next allocation */
+  Pool.deallocate(Blocks.at(3));
+  EXPECT_EQ(Pool.allocate(), Blocks.at(3));
+
+  /** freeing nothing is allowed */
+  Pool.deallocate(nullptr);
+
+  for (void* Block : Blocks)
+  {
+    Pool.deallocate(Block);
+  }
+}
+
+TEST(MemoryPool, SharedPoolsBySize)
+{
+  EXPECT_EQ(libRSF::MemoryPool::Get(0), nullptr);
+  EXPECT_EQ(libRSF::MemoryPool::Get(libRSF::MemoryPool::MaxObjectSize + 1), nullptr);
+
+  /** sizes are rounded up to the granularity */
+  const size_t Granularity = libRSF::MemoryPool::Granularity;
+  EXPECT_EQ(libRSF::MemoryPool::Get(1), libRSF::MemoryPool::Get(Granularity));
+  EXPECT_NE(libRSF::MemoryPool::Get(Granularity), libRSF::MemoryPool::Get(Granularity + 1));
+
+  for (const size_t Size : {size_t(1), size_t(17), size_t(100), libRSF::MemoryPool::MaxObjectSize})
+  {
+    ASSERT_NE(libRSF::MemoryPool::Get(Size), nullptr);
+    EXPECT_GE(libRSF::MemoryPool::Get(Size)->getBlockSize(), Size);
+  }
+}
+
+TEST(MemoryPool, PoolAllocatedObjects)
+{
+  /** small objects come from their pool and are reused */
+  SmallObject* First = new SmallObject;
+  delete First;
+  SmallObject* Second = new SmallObject;
+  EXPECT_EQ(First, Second);
+  delete Second;
+
+  /** large and over-aligned objects bypass the pools */
+  LargeObject* Large = new LargeObject;
+  Large->Values[2 * libRSF::MemoryPool::MaxObjectSize - 1] = 1.0;
+  delete Large;
+
+  AlignedObject* Aligned = new AlignedObject;
+  EXPECT_TRUE(IsAligned(Aligned, 64));
+  delete Aligned;
+
+  /** deleting through a base pointer returns the block to the pool of the derived type */
+  Base* Object = new libRSF::Pooled<Base>;
+  const void* Address = Object;
+  delete Object;
+  libRSF::Pooled<Base>* Reused = new libRSF::Pooled<Base>;
+  EXPECT_EQ(static_cast<const void*>(static_cast<Base*>(Reused)), Address);
+  delete Reused;
+}
+
+TEST(MemoryPool, ConcurrentAllocations)
+{
+  libRSF::MemoryPool Pool(32, 16);
+  const int Threads = 4;
+  const int Blocks = 1000;
+
+  /** every thread fills its blocks with its own number, overlapping blocks would be overwritten */
+  std::vector<std::vector<int*>> Allocated(Threads);
+  std::vector<std::thread> Workers;
+  for (int t = 0; t < Threads; t++)
+  {
+    Workers.emplace_back([&Pool, &Allocated, t]()
+    {
+      for (int n = 0; n < Blocks; n++)
+      {
+        int* Block = static_cast<int*>(Pool.allocate());
+        *Block = t;
+        Allocated.at(t).push_back(Block);
+
+        /** free every second block again to mix allocations and deallocations */
+        if (n % 2 == 1)
+        {
+          Pool.deallocate(Allocated.at(t).front());
+          Allocated.at(t).erase(Allocated.at(t).begin());
+        }
+      }
+    });
+  }
+  for (std::thread &Thread : Workers)
+  {
+    Thread.join();
+  }
+
+  std::set<int*> Unique;
+  for (int t = 0; t < Threads; t++)
+  {
+    for (int* Block : Allocated.at(t))
+    {
+      EXPECT_EQ(*Block, t);
+      Unique.insert(Block);
+    }
+  }
+  EXPECT_EQ(static_cast<int>(Unique.size()), Threads * Blocks / 2);
+
+  for (int* Block : Unique)
+  {
+    Pool.deallocate(Block);
+  }
+}
+
+// main provided by linking to gtest_main
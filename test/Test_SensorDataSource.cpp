@@ -0,0 +1,234 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_SensorDataSource.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks the lock-free queue and the reorder buffer of the streaming interface.
+ * @copyright GNU Public License.
+ *
+ */
+
+#include "SensorDataSource.h"
+#include "gtest/gtest.h"
+
+static const std::string InputFile = "datasets/Indoor UWB/Indoor_UWB_Input.txt";
+
+/** all timestamps of one type in their order inside the set */
+static std::vector<double> GetTimestamps(const libRSF::SensorDataSet &Set, const libRSF::DataType Type)
+{
+  std::vector<double> Timestamps;
+  double Time;
+  if (Set.getTimeFirst(Type, Time))
+  {
+    do
+    {
+      for (int n = 0; n < Set.countElement(Type, Time); n++)
+      {
+        Timestamps.push_back(Time);
+      }
+    }
+    while (Set.getTimeNext(Type, Time, Time));
+  }
+  return Timestamps;
+}
+
+/** number of measurements over all types */
+static int CountAll(const libRSF::SensorDataSet &Set)
+{
+  int Number = 0;
+  for (const auto &Stream : Set)
+  {
+    Number += Set.countElements(Stream.first);
+  }
+  return Number;
+}
+
+static libRSF::Data CreateMeasurement(const double Timestamp)
+{
+  libRSF::Data Measurement(libRSF::DataType::Point1, Timestamp);
+  Measurement.setMean(libRSF::Vector1::Constant(Timestamp));
+  return Measurement;
+}
+
+TEST(LockFreeQueue, CapacityAndOrder)
+{
+  libRSF::LockFreeQueue<int> Queue(3);
+  EXPECT_TRUE(Queue.empty());
+
+  EXPECT_TRUE(Queue.push(1));
+  EXPECT_TRUE(Queue.push(2));
+  EXPECT_TRUE(Queue.push(3));
+  EXPECT_FALSE(Queue.push(4)) << "Queue accepts more objects than its capacity";
+
+  int Value;
+  for (int Expected = 1; Expected <= 3; Expected++)
+  {
+    ASSERT_TRUE(Queue.pop(Value));
+    EXPECT_EQ(Value, Expected);
+  }
+  EXPECT_FALSE(Queue.pop(Value));
+  EXPECT_TRUE(Queue.empty());
+}
+
+TEST(LockFreeQueue, ProducerConsumer)
+{
+  const int Number = 10000;
+  libRSF::LockFreeQueue<int> Queue(64);
+
+  std::thread Producer([&Queue, Number]()
+  {
+    for (int n = 0; n < Number; n++)
+    {
+      while (!Queue.push(n))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  /** the consumer has to see every object exactly once and in order */
+  int Expected = 0;
+  int Value;
+  while (Expected < Number)
+  {
+    if (Queue.pop(Value))
+    {
+      ASSERT_EQ(Value, Expected);
+      Expected++;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  Producer.join();
+
+  EXPECT_TRUE(Queue.empty());
+}
+
+TEST(SensorDataSource, ReorderBuffer)
+{
+  libRSF::SensorDataSource Source(64, 0.5);
+  EXPECT_EQ(Source.getLatency(), 0.0) << "Latency has to be zero before the first batch";
+
+  /** out of order arrival */
+  for (const double Timestamp : {1.0, 0.8, 1.2, 2.0})
+  {
+    ASSERT_TRUE(Source.push(CreateMeasurement(Timestamp)));
+  }
+
+  /** everything before the watermark 2.0 - 0.5 is released in time order */
+  libRSF::SensorDataSet Batch;
+  ASSERT_TRUE(Source.pullBatch(Batch));
+  EXPECT_EQ(GetTimestamps(Batch, libRSF::DataType::Point1), std::vector<double>({0.8, 1.0, 1.2}));
+  EXPECT_GE(Source.getLatency(), 0.0);
+
+  /** the newest measurement is released at the end of the stream */
+  Source.finish();
+  libRSF::SensorDataSet LastBatch;
+  ASSERT_TRUE(Source.pullBatch(LastBatch));
+  EXPECT_EQ(GetTimestamps(LastBatch, libRSF::DataType::Point1), std::vector<double>({2.0}));
+  EXPECT_TRUE(Source.isFinished());
+}
+
+TEST(SensorDataSource, LateMeasurementsAreDropped)
+{
+  libRSF::SensorDataSource Source(64, 0.0);
+
+  ASSERT_TRUE(Source.push(CreateMeasurement(1.0)));
+  ASSERT_TRUE(Source.push(CreateMeasurement(2.0)));
+
+  libRSF::SensorDataSet Batch;
+  ASSERT_TRUE(Source.pullBatch(2.0, Batch));
+  EXPECT_EQ(GetTimestamps(Batch, libRSF::DataType::Point1), std::vector<double>({1.0, 2.0}));
+
+  /** this part of the timeline was already released */
+  ASSERT_TRUE(Source.push(CreateMeasurement(1.5)));
+  ASSERT_TRUE(Source.push(CreateMeasurement(3.0)));
+
+  libRSF::SensorDataSet NextBatch;
+  ASSERT_TRUE(Source.pullBatch(3.0, NextBatch));
+  EXPECT_EQ(GetTimestamps(NextBatch, libRSF::DataType::Point1), std::vector<double>({3.0}));
+  EXPECT_EQ(Source.getDroppedNumber(), 1);
+}
+
+TEST(SensorDataSource, ReadingStopsAtHandle)
+{
+  int Number = 0;
+  libRSF::ReadDataFromFile(InputFile, [&Number](const libRSF::Data &)
+  {
+    Number++;
+    return Number < 10;
+  });
+
+  EXPECT_EQ(Number, 10);
+}
+
+TEST(SensorDataSource, ReadingInTimeOrder)
+{
+  libRSF::SensorDataSet Expected;
+  libRSF::ReadDataFromFile(InputFile, Expected);
+
+  /** the file is grouped by type, so the runs have to be merged */
+  int Number = 0;
+  double Last = -std::numeric_limits<double>::infinity();
+  bool Ordered = true;
+  libRSF::ReadDataFromFileInTimeOrder(InputFile, [&](const libRSF::Data &Measurement)
+  {
+    Ordered = Ordered && (Measurement.getTimestamp() >= Last);
+    Last = Measurement.getTimestamp();
+    Number++;
+    return true;
+  });
+
+  EXPECT_TRUE(Ordered);
+  EXPECT_EQ(Number, CountAll(Expected));
+}
+
+TEST(SensorDataSource, FileReplay)
+{
+  libRSF::SensorDataSet Expected;
+  libRSF::ReadDataFromFile(InputFile, Expected);
+
+  /** replay as fast as possible, the buffer is smaller than the file */
+  libRSF::SensorDataSource Source(64, 0.0);
+  libRSF::FileReplaySource Replay(InputFile, Source, 0.0);
+  Replay.start();
+
+  libRSF::SensorDataSet Received;
+  while (!Source.isFinished())
+  {
+    if (!Source.pullBatch(Received))
+    {
+      std::this_thread::yield();
+    }
+  }
+  Replay.stop();
+
+  EXPECT_EQ(CountAll(Received), CountAll(Expected));
+  EXPECT_EQ(Source.getDroppedNumber(), 0);
+}
+
+// main provided by linking to gtest_main
@@ -0,0 +1,121 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_SharedErrorModel.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks when replaced models of a shared error model become visible.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "error_models/SharedErrorModel.h"
+#include "gtest/gtest.h"
+
+/** mixture with a single zero-mean component */
+static libRSF::MaxMix1 CreateModel(const double StdDev)
+{
+  libRSF::GaussianComponent<1> Gaussian;
+  Gaussian.setParamsStdDev(libRSF::Vector1::Constant(StdDev), libRSF::Vector1::Zero(), libRSF::Vector1::Ones());
+
+  libRSF::GaussianMixture<1> Mixture;
+  Mixture.addComponent(Gaussian);
+  return libRSF::MaxMix1(Mixture);
+}
+
+/** the weighted error of a fixed raw error */
+template <typename ModelType>
+static libRSF::Vector2 Weight(const ModelType &Model)
+{
+  const libRSF::Vector1 RawError = libRSF::Vector1::Constant(2.0);
+  libRSF::Vector2 Error;
+  EXPECT_TRUE(Model.template weight<double>(RawError, Error.data()));
+  return Error;
+}
+
+TEST(SharedErrorModel, SameResultAsModel)
+{
+  const libRSF::MaxMix1 Model = CreateModel(1.0);
+  const libRSF::SharedMaxMix1 Shared(Model);
+
+  EXPECT_TRUE(Weight(Shared).isApprox(Weight(Model)));
+}
+
+TEST(SharedErrorModel, ReplacementIsVisibleAfterPin)
+{
+  libRSF::SharedMaxMix1 Shared(CreateModel(1.0));
+  const libRSF::SharedMaxMix1 Copy = Shared;
+  EXPECT_TRUE(Copy.isSharedWith(Shared));
+
+  const libRSF::Vector2 Old = Weight(CreateModel(1.0));
+  const libRSF::Vector2 New = Weight(CreateModel(2.0));
+  ASSERT_FALSE(Old.isApprox(New));
+
+  /** the evaluation keeps the pinned model, the latest one is already available */
+  Shared.setModel(CreateModel(2.0));
+  EXPECT_TRUE(Weight(Shared).isApprox(Old));
+  EXPECT_TRUE(Weight(Copy).isApprox(Old));
+  EXPECT_TRUE(Weight(*Copy.getModel()).isApprox(New));
+
+  /** one pin affects all copies */
+  Shared.pinModel();
+  EXPECT_TRUE(Weight(Shared).isApprox(New));
+  EXPECT_TRUE(Weight(Copy).isApprox(New));
+}
+
+TEST(SharedErrorModel, ReadersKeepTheirModel)
+{
+  libRSF::SharedMaxMix1 Shared(CreateModel(1.0));
+  const std::shared_ptr<const libRSF::MaxMix1> Model = Shared.getModel();
+
+  /** the old model stays valid and unchanged after it was replaced */
+  Shared.setModel(CreateModel(2.0));
+  Shared.pinModel();
+  EXPECT_TRUE(Weight(*Model).isApprox(Weight(CreateModel(1.0))));
+  EXPECT_NE(Shared.getModel(), Model);
+}
+
+TEST(SharedErrorModel, IndependentModelsAreNotShared)
+{
+  libRSF::SharedMaxMix1 First(CreateModel(1.0));
+  const libRSF::SharedMaxMix1 Second(CreateModel(1.0));
+  EXPECT_FALSE(First.isSharedWith(Second));
+
+  First.setModel(CreateModel(2.0));
+  First.pinModel();
+  EXPECT_TRUE(Weight(Second).isApprox(Weight(CreateModel(1.0))));
+}
+
+TEST(SharedErrorModel, DisabledPassesRawError)
+{
+  libRSF::SharedMaxMix1 Shared(CreateModel(2.0));
+  Shared.disable();
+
+  const libRSF::Vector2 Error = Weight(Shared);
+  EXPECT_DOUBLE_EQ(Error(0), 2.0);
+  EXPECT_DOUBLE_EQ(Error(1), 0.0);
+}
+
+// main provided by linking to gtest_main
@@ -0,0 +1,108 @@
+/***************************************************************************
+ * libRSF - A Robust Sensor Fusion Library
+ *
+ * Copyright (C) 2026 Chair of Automation Technology / TU Chemnitz
+ * For more information see https://www.tu-chemnitz.de/etit/proaut/libRSF
+ *
+ * libRSF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libRSF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libRSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: libRSF contributors
+ ***************************************************************************/
+
+
+/**
+ * @file Test_Tick.cpp
+ * @author libRSF contributors
+ * @date 16.10.2026
+ * @brief Checks the rounding and comparison of integer timestamps and their use as keys.
+ * @copyright GNU Public License.
+ *
+ */
+
+
+#include "Tick.h"
+#include "StateDataSet.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <unordered_set>
+
+TEST(Tick, RoundsToNearestTick)
+{
+  const double Half = 0.5 * libRSF::Tick::SecondsPerTick;
+
+  EXPECT_EQ(libRSF::Tick(0.1 + 0.2), libRSF::Tick(0.3));
+  EXPECT_EQ(libRSF::Tick(1.0 + 0.8 * Half), libRSF::Tick(1.0));
+  EXPECT_EQ(libRSF::Tick(1.0 - 0.8 * Half), libRSF::Tick(1.0));
+  EXPECT_NE(libRSF::Tick(1.0 + 1.2 * Half), libRSF::Tick(1.0));
+  EXPECT_EQ(libRSF::Tick(-1.0).count(), -libRSF::Tick::TicksPerSecond);
+}
+
+TEST(Tick, ComparesAsInteger)
+{
+  const libRSF::Tick Early(-0.5), Zero(0.0), Late(2.5);
+
+  EXPECT_LT(Early, Zero);
+  EXPECT_LE(Zero, libRSF::Tick(0.0));
+  EXPECT_GT(Late, Zero);
+  EXPECT_GE(Late, libRSF::Tick(2.5));
+  EXPECT_EQ(libRSF::Tick::FromCount(Late.count()), Late);
+  EXPECT_EQ(libRSF::Tick(), Zero);
+}
+
+TEST(Tick, ConvertsToSeconds)
+{
+  const libRSF::Tick Time(2.5);
+  const double Seconds = Time;
+
+  EXPECT_DOUBLE_EQ(Seconds, 2.5);
+  EXPECT_DOUBLE_EQ(Time.toSeconds(), 2.5);
+
+  libRSF::Tick Assigned;
+  Assigned = 1.25;
+  EXPECT_EQ(Assigned, libRSF::Tick(1.25));
+
+  std::stringstream Stream;
+  Stream << Time;
+  EXPECT_EQ(Stream.str(), "2.5");
+}
+
+TEST(Tick, EqualTicksHaveEqualHashes)
+{
+  std::unordered_set<libRSF::Tick> Set;
+  Set.insert(libRSF::Tick(0.3));
+  Set.insert(libRSF::Tick(0.1 + 0.2));
+  Set.insert(libRSF::Tick(0.4));
+
+  EXPECT_EQ(Set.size(), 2u);
+  EXPECT_EQ(Set.count(libRSF::Tick(0.3)), 1u);
+}
+
+TEST(Tick, DataSetKeysAreRobustToRounding)
+{
+  libRSF::StateDataSet Set;
+  Set.addElement("A", 0.3, libRSF::Data(libRSF::DataType::Point1, 0.3));
+  Set.addElement("A", 0.1, libRSF::Data(libRSF::DataType::Point1, 0.1));
+
+  /** the same timestamp, computed in a different way */
+  EXPECT_TRUE(Set.checkElement("A", 0.1 + 0.2));
+  EXPECT_EQ(Set.countElement("A", 0.1 + 0.2), 1);
+
+  double Next;
+  ASSERT_TRUE(Set.getTimeNext("A", 0.1, Next));
+  EXPECT_DOUBLE_EQ(Next, libRSF::roundToTick(0.3));
+  EXPECT_EQ(libRSF::Tick(Next), libRSF::Tick(0.3));
+}
+
+// main provided by linking to gtest_main